@@ -0,0 +1,1045 @@
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 199309L /* clock_gettime() */
+#endif
+#ifdef _WINDOWS
+#define _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "leptjson.h"
+
+/* Each case is repeated until it has run for at least this many seconds. */
+#ifndef BENCH_MIN_SECONDS
+#define BENCH_MIN_SECONDS 0.5
+#endif
+
+typedef struct {
+    char* json;
+    size_t size, capacity;
+}bench_buffer;
+
+static void bench_append(bench_buffer* b, const char* s, size_t len) {
+    if (b->size + len + 1 > b->capacity) {
+        while (b->size + len + 1 > b->capacity)
+            b->capacity = b->capacity == 0 ? 4096 : b->capacity * 2;
+        b->json = (char*)realloc(b->json, b->capacity);
+    }
+    memcpy(b->json + b->size, s, len);
+    b->size += len;
+    b->json[b->size] = '\0';
+}
+
+#define APPENDS(b, s) bench_append(b, s, strlen(s))
+
+static void bench_newline(bench_buffer* b, int indent, int level) {
+    int i;
+    if (indent == 0)
+        return;
+    APPENDS(b, "\n");
+    for (i = 0; i < indent * level; i++)
+        APPENDS(b, " ");
+}
+
+/* An array of flat records, optionally pretty-printed with `indent` spaces per level. */
+static char* bench_records(size_t count, int indent, size_t* length) {
+    static const char* names[] = { "alpha", "bravo", "charlie", "delta", "echo", "foxtrot" };
+    bench_buffer b = { NULL, 0, 0 };
+    char buf[128];
+    size_t i;
+    APPENDS(&b, "[");
+    for (i = 0; i < count; i++) {
+        if (i > 0)
+            APPENDS(&b, ",");
+        bench_newline(&b, indent, 1);
+        APPENDS(&b, "{");
+        bench_newline(&b, indent, 2);
+        sprintf(buf, "\"id\":%s%lu,", indent ? " " : "", (unsigned long)(i * 7919));
+        APPENDS(&b, buf);
+        bench_newline(&b, indent, 2);
+        sprintf(buf, "\"name\":%s\"%s-%lu\",", indent ? " " : "", names[i % 6], (unsigned long)i);
+        APPENDS(&b, buf);
+        bench_newline(&b, indent, 2);
+        sprintf(buf, "\"score\":%s%.6f,", indent ? " " : "", (double)i / 3.0);
+        APPENDS(&b, buf);
+        bench_newline(&b, indent, 2);
+        sprintf(buf, "\"active\":%s%s,", indent ? " " : "", i % 2 ? "true" : "false");
+        APPENDS(&b, buf);
+        bench_newline(&b, indent, 2);
+        sprintf(buf, "\"tags\":%s[\"x\",%s\"y\",%s\"z\"]", indent ? " " : "", indent ? " " : "", indent ? " " : "");
+        APPENDS(&b, buf);
+        bench_newline(&b, indent, 1);
+        APPENDS(&b, "}");
+    }
+    bench_newline(&b, indent, 0);
+    APPENDS(&b, "]");
+    *length = b.size;
+    return b.json;
+}
+
+static void bench_report(const char* name, size_t bytes, size_t iterations, double seconds) {
+    printf("%-36s %10.1f MB/s  %8.3f ms/iter\n", name,
+        bytes * (double)iterations / seconds / 1e6, seconds * 1e3 / iterations);
+}
+
+/* What a timed callback returns when its result is not the expected one. */
+#define BENCH_WRONG_RESULT (-1)
+
+/*
+ * Calls run(ctx) until BENCH_MIN_SECONDS of CPU time have passed, returning
+ * the seconds taken and the number of calls in *iterations. A callback that
+ * returns anything but LEPT_PARSE_OK stops the benchmark.
+ */
+static double bench_time(const char* name, int (*run)(void*), void* ctx, size_t* iterations) {
+    size_t n = 0;
+    clock_t start = clock();
+    double seconds;
+    int ret;
+    do {
+        if ((ret = run(ctx)) != LEPT_PARSE_OK) {
+            fprintf(stderr, "%s: %s\n", name, ret == BENCH_WRONG_RESULT ? "wrong result" : "parse error");
+            exit(1);
+        }
+        n++;
+    } while ((seconds = (double)(clock() - start) / CLOCKS_PER_SEC) < BENCH_MIN_SECONDS);
+    *iterations = n;
+    return seconds;
+}
+
+/* Times run(ctx) and reports it as throughput over `bytes` of input per call. */
+static void bench_run(const char* name, size_t bytes, int (*run)(void*), void* ctx) {
+    size_t n;
+    double seconds = bench_time(name, run, ctx, &n);
+    bench_report(name, bytes, n, seconds);
+}
+
+/* The input of a timed case, and what its callback keeps between calls. */
+typedef struct {
+    const char* json;
+    size_t length;
+    unsigned flags;
+    size_t chunk;                           /* bench_parse_push(): bytes per lept_parser_feed() */
+    double (*read)(const char*, size_t);    /* bench_result(): the reader, and what it must return */
+    double expect;
+    void* state;                            /* a value, buffer, parser or document */
+}bench_input;
+
+static void bench_input_init(bench_input* in, const char* json, size_t length) {
+    memset(in, 0, sizeof(bench_input));
+    in->json = json;
+    in->length = length;
+}
+
+static int bench_parse_once(void* ctx) {
+    const bench_input* in = (const bench_input*)ctx;
+    lept_value v;
+    int ret;
+    lept_init(&v);
+    if ((ret = lept_parse(&v, in->json)) == LEPT_PARSE_OK)
+        lept_free(&v);
+    return ret;
+}
+
+static int bench_parse_ex_once(void* ctx) {
+    const bench_input* in = (const bench_input*)ctx;
+    lept_value v;
+    int ret;
+    lept_init(&v);
+    if ((ret = lept_parse_ex(&v, in->json, in->length, in->flags)) == LEPT_PARSE_OK)
+        lept_free(&v);
+    return ret;
+}
+
+static void bench_parse(const char* name, const char* json, size_t length) {
+    bench_input in;
+    bench_input_init(&in, json, length);
+    bench_run(name, length, bench_parse_once, &in);
+}
+
+static void bench_parse_ex(const char* name, const char* json, size_t length, unsigned flags) {
+    bench_input in;
+    bench_input_init(&in, json, length);
+    in.flags = flags;
+    bench_run(name, length, bench_parse_ex_once, &in);
+}
+
+static int bench_parse_tape_once(void* ctx) {
+    const bench_input* in = (const bench_input*)ctx;
+    lept_tape t;
+    int ret;
+    if ((ret = lept_parse_tape(&t, in->json, in->length)) == LEPT_PARSE_OK)
+        lept_tape_free(&t);
+    return ret;
+}
+
+static void bench_parse_tape(const char* name, const char* json, size_t length) {
+    bench_input in;
+    bench_input_init(&in, json, length);
+    bench_run(name, length, bench_parse_tape_once, &in);
+}
+
+static int bench_stringify_once(void* ctx) {
+    free(lept_stringify((const lept_value*)((bench_input*)ctx)->state, NULL));
+    return LEPT_PARSE_OK;
+}
+
+static void bench_stringify(const char* name, const char* json, size_t length) {
+    lept_value v;
+    bench_input in;
+    lept_init(&v);
+    if (lept_parse(&v, json) != LEPT_PARSE_OK) {
+        fprintf(stderr, "%s: parse error\n", name);
+        exit(1);
+    }
+    bench_input_init(&in, json, length);
+    in.state = &v;
+    bench_run(name, length, bench_stringify_once, &in);
+    lept_free(&v);
+}
+
+static int bench_parse_insitu_once(void* ctx) {
+    const bench_input* in = (const bench_input*)ctx;
+    lept_value v;
+    int ret;
+    lept_init(&v);
+    memcpy(in->state, in->json, in->length + 1);
+    if ((ret = lept_parse_insitu(&v, (char*)in->state)) == LEPT_PARSE_OK)
+        lept_free(&v);
+    return ret;
+}
+
+/* The source buffer is restored from `json` before every iteration, and that copy is timed too. */
+static void bench_parse_insitu(const char* name, const char* json, size_t length) {
+    bench_input in;
+    bench_input_init(&in, json, length);
+    in.state = malloc(length + 1);
+    bench_run(name, length, bench_parse_insitu_once, &in);
+    free(in.state);
+}
+
+static void bench_whitespace() {
+    size_t length;
+    char* json;
+    json = bench_records(20000, 0, &length);
+    bench_parse("parse minified", json, length);
+    free(json);
+    json = bench_records(20000, 4, &length);
+    bench_parse("parse indented (4 spaces)", json, length);
+    free(json);
+    json = bench_records(20000, 8, &length);
+    bench_parse("parse indented (8 spaces)", json, length);
+    free(json);
+}
+
+/* An array of long plain strings, with an occasional escape. */
+static char* bench_strings(size_t count, size_t width, size_t* length) {
+    bench_buffer b = { NULL, 0, 0 };
+    size_t i, j;
+    APPENDS(&b, "[");
+    for (i = 0; i < count; i++) {
+        APPENDS(&b, i > 0 ? ",\"" : "\"");
+        for (j = 0; j < width; j++)
+            bench_append(&b, &"abcdefghijklmnopqrstuvwxyz 0123456789"[(i + j) % 37], 1);
+        if (i % 8 == 0)
+            APPENDS(&b, "\\n\\u00e9");
+        APPENDS(&b, "\"");
+    }
+    APPENDS(&b, "]");
+    *length = b.size;
+    return b.json;
+}
+
+static void bench_string() {
+    size_t length;
+    char* json;
+    json = bench_strings(20000, 16, &length);
+    bench_parse("parse strings (16 bytes)", json, length);
+    free(json);
+    json = bench_strings(5000, 256, &length);
+    bench_parse("parse strings (256 bytes)", json, length);
+    free(json);
+}
+
+/* An array of numbers in the shapes telemetry tends to have: counters, fixed-point and full precision. */
+static char* bench_numbers(size_t count, size_t* length) {
+    bench_buffer b = { NULL, 0, 0 };
+    char buf[64];
+    size_t i;
+    APPENDS(&b, "[");
+    for (i = 0; i < count; i++) {
+        switch (i % 4) {
+            case 0: sprintf(buf, "%lu", (unsigned long)(i * 2654435761UL % 1000000)); break;
+            case 1: sprintf(buf, "%.3f", i * 0.001 - 17.5); break;
+            case 2: sprintf(buf, "%.17g", 1.0 / (i + 3)); break;
+            default: sprintf(buf, "%.6e", i * 1.2345e-7); break;
+        }
+        APPENDS(&b, i > 0 ? "," : "");
+        APPENDS(&b, buf);
+    }
+    APPENDS(&b, "]");
+    *length = b.size;
+    return b.json;
+}
+
+static void bench_number() {
+    size_t length;
+    char* json = bench_numbers(100000, &length);
+    bench_parse("parse numbers", json, length);
+    bench_stringify("stringify numbers", json, length);
+    free(json);
+}
+
+/* An array of `count` chains of `depth` nested containers, alternating arrays and objects. */
+static char* bench_nested(size_t count, size_t depth, size_t* length) {
+    bench_buffer b = { NULL, 0, 0 };
+    size_t i, j;
+    APPENDS(&b, "[");
+    for (i = 0; i < count; i++) {
+        APPENDS(&b, i > 0 ? "," : "");
+        for (j = 0; j < depth; j++)
+            APPENDS(&b, j % 2 ? "{\"k\":" : "[0,");
+        APPENDS(&b, "null");
+        for (j = depth; j-- > 0; )
+            APPENDS(&b, j % 2 ? "}" : "]");
+    }
+    APPENDS(&b, "]");
+    *length = b.size;
+    return b.json;
+}
+
+static void bench_nesting() {
+    size_t length;
+    char* json = bench_nested(2000, 256, &length);
+    bench_parse("parse nested containers", json, length);
+    free(json);
+}
+
+static void bench_indexed() {
+    size_t length;
+    char* json;
+    json = bench_records(20000, 0, &length);
+    bench_parse_ex("parse minified", json, length, 0);
+    bench_parse_ex("parse minified indexed", json, length, LEPT_PARSE_FLAG_INDEXED);
+    free(json);
+    json = bench_records(20000, 4, &length);
+    bench_parse_ex("parse indented (4 spaces)", json, length, 0);
+    bench_parse_ex("parse indented (4 spaces) indexed", json, length, LEPT_PARSE_FLAG_INDEXED);
+    free(json);
+    json = bench_strings(5000, 256, &length);
+    bench_parse_ex("parse strings (256 bytes)", json, length, 0);
+    bench_parse_ex("parse strings (256 bytes) indexed", json, length, LEPT_PARSE_FLAG_INDEXED);
+    free(json);
+    json = bench_numbers(100000, &length);
+    bench_parse_ex("parse numbers", json, length, 0);
+    bench_parse_ex("parse numbers indexed", json, length, LEPT_PARSE_FLAG_INDEXED);
+    free(json);
+}
+
+static void bench_tape() {
+    size_t length;
+    char* json;
+    json = bench_records(20000, 0, &length);
+    bench_parse("parse records", json, length);
+    bench_parse_tape("parse records to tape", json, length);
+    free(json);
+    json = bench_numbers(100000, &length);
+    bench_parse("parse numbers", json, length);
+    bench_parse_tape("parse numbers to tape", json, length);
+    free(json);
+}
+
+/* A ~20 KB request: a large payload member followed by the few fields a handler reads. */
+static char* bench_request(size_t* length) {
+    bench_buffer b = { NULL, 0, 0 };
+    size_t len;
+    char* records = bench_records(120, 0, &len);
+    APPENDS(&b, "{\"payload\":");
+    APPENDS(&b, records);
+    APPENDS(&b, ",\"user\":{\"id\":42,\"name\":\"bench\"},\"timeout\":2.5,\"retries\":3,\"scale\":[1,2,3]}");
+    free(records);
+    *length = b.size;
+    return b.json;
+}
+
+static double bench_read_tree(const char* json, size_t length) {
+    lept_value v;
+    double sum;
+    lept_init(&v);
+    if (lept_parse_n(&v, json, length) != LEPT_PARSE_OK)
+        exit(1);
+    sum = lept_get_number(lept_find_object_value(lept_find_object_value(&v, "user", 4), "id", 2))
+        + lept_get_number(lept_find_object_value(&v, "timeout", 7))
+        + lept_get_number(lept_find_object_value(&v, "retries", 7))
+        + lept_get_number(lept_get_array_element(lept_find_object_value(&v, "scale", 5), 2));
+    lept_free(&v);
+    return sum;
+}
+
+static double bench_read_cursor(const char* json, size_t length) {
+    lept_doc d;
+    lept_cursor root, f, e;
+    double n, sum = 0.0;
+    lept_doc_init(&d, json, length);
+    if (lept_doc_root(&d, &root) != LEPT_PARSE_OK
+        || lept_cursor_find_field(&root, "user", 4, &f) != LEPT_PARSE_OK
+        || lept_cursor_find_field(&f, "id", 2, &f) != LEPT_PARSE_OK
+        || lept_cursor_get_double(&f, &n) != LEPT_PARSE_OK)
+        exit(1);
+    sum += n;
+    if (lept_cursor_find_field(&root, "timeout", 7, &f) != LEPT_PARSE_OK || lept_cursor_get_double(&f, &n) != LEPT_PARSE_OK)
+        exit(1);
+    sum += n;
+    if (lept_cursor_find_field(&root, "retries", 7, &f) != LEPT_PARSE_OK || lept_cursor_get_double(&f, &n) != LEPT_PARSE_OK)
+        exit(1);
+    sum += n;
+    if (lept_cursor_find_field(&root, "scale", 5, &f) != LEPT_PARSE_OK)
+        exit(1);
+    while (lept_cursor_array_next(&f, &e) == LEPT_PARSE_OK)
+        if (lept_cursor_get_double(&e, &n) == LEPT_PARSE_OK && n == 3.0)
+            sum += n;
+    return sum;
+}
+
+static int bench_result_once(void* ctx) {
+    const bench_input* in = (const bench_input*)ctx;
+    return in->read(in->json, in->length) == in->expect ? LEPT_PARSE_OK : BENCH_WRONG_RESULT;
+}
+
+/* Times a reader that must return `expect` for the input. */
+static void bench_result(const char* name, double (*read)(const char*, size_t), const char* json, size_t length, double expect) {
+    bench_input in;
+    bench_input_init(&in, json, length);
+    in.read = read;
+    in.expect = expect;
+    bench_run(name, length, bench_result_once, &in);
+}
+
+static void bench_on_demand() {
+    size_t length;
+    char* json = bench_request(&length);
+    bench_result("read 4 fields, parse tree", bench_read_tree, json, length, 50.5);
+    bench_result("read 4 fields, cursors", bench_read_cursor, json, length, 50.5);
+    free(json);
+}
+
+static int bench_parse_push_once(void* ctx) {
+    const bench_input* in = (const bench_input*)ctx;
+    lept_parser* p = (lept_parser*)in->state;
+    lept_value v;
+    size_t i;
+    int ret;
+    for (i = 0; i < in->length; i += in->chunk)
+        lept_parser_feed(p, in->json + i, in->length - i < in->chunk ? in->length - i : in->chunk);
+    if ((ret = lept_parser_finish(p, &v)) == LEPT_PARSE_OK)
+        lept_free(&v);
+    return ret;
+}
+
+static void bench_parse_push(const char* name, const char* json, size_t length, size_t chunk) {
+    bench_input in;
+    bench_input_init(&in, json, length);
+    in.chunk = chunk;
+    in.state = lept_parser_create();
+    bench_run(name, length, bench_parse_push_once, &in);
+    lept_parser_free((lept_parser*)in.state);
+}
+
+static void bench_push() {
+    size_t length;
+    char* json = bench_records(20000, 0, &length);
+    bench_parse("parse records", json, length);
+    bench_parse_push("parse records, 64 KB chunks", json, length, 65536);
+    bench_parse_push("parse records, 4 KB chunks", json, length, 4096);
+    bench_parse_push("parse records, 16 byte chunks", json, length, 16);
+    free(json);
+}
+
+/* Sums the "score" of every record, the way a struct-filling reader would. */
+static double bench_sum_tree(const char* json, size_t length) {
+    lept_value v;
+    double sum = 0.0;
+    size_t i;
+    (void)length;
+    lept_init(&v);
+    if (lept_parse(&v, json) != LEPT_PARSE_OK)
+        exit(1);
+    for (i = 0; i < lept_get_array_size(&v); i++)
+        sum += lept_get_number(lept_find_object_value(lept_get_array_element(&v, i), "score", 5));
+    lept_free(&v);
+    return sum;
+}
+
+typedef struct {
+    double sum;
+    int score;  /* the next number is a score */
+}bench_sum;
+
+static int bench_sum_key(void* ctx, const char* k, size_t klen) {
+    ((bench_sum*)ctx)->score = klen == 5 && memcmp(k, "score", 5) == 0;
+    return LEPT_PARSE_OK;
+}
+
+static int bench_sum_number(void* ctx, double n) {
+    bench_sum* s = (bench_sum*)ctx;
+    if (s->score)
+        s->sum += n;
+    return LEPT_PARSE_OK;
+}
+
+static double bench_sum_sax(const char* json, size_t length) {
+    static const lept_handler h = { NULL, NULL, bench_sum_number, NULL, NULL, NULL, NULL, bench_sum_key };
+    bench_sum s;
+    (void)length;
+    s.sum = 0.0;
+    s.score = 0;
+    if (lept_parse_sax(&h, &s, json) != LEPT_PARSE_OK)
+        exit(1);
+    return s.sum;
+}
+
+static void bench_sax() {
+    size_t length;
+    char* json = bench_records(20000, 0, &length);
+    double expect = bench_sum_tree(json, length);
+    bench_result("sum scores, parse tree", bench_sum_tree, json, length, expect);
+    bench_result("sum scores, SAX", bench_sum_sax, json, length, expect);
+    free(json);
+}
+
+/* JSON Lines: one flat record per line. */
+static char* bench_lines(size_t count, size_t* length) {
+    bench_buffer b = { NULL, 0, 0 };
+    char buf[160];
+    size_t i;
+    for (i = 0; i < count; i++) {
+        sprintf(buf, "{\"id\":%lu,\"name\":\"user-%lu\",\"score\":%.6f,\"active\":%s}\n",
+            (unsigned long)(i * 7919), (unsigned long)i, (double)i / 3.0, i % 2 ? "true" : "false");
+        APPENDS(&b, buf);
+    }
+    *length = b.size;
+    return b.json;
+}
+
+static double bench_lines_parse_n(const char* json, size_t length) {
+    const char* p = json, *end = json + length;
+    size_t count = 0;
+    while (p < end) {
+        const char* eol = (const char*)memchr(p, '\n', end - p);
+        lept_value v;
+        lept_init(&v);
+        if (lept_parse_n(&v, p, eol - p) != LEPT_PARSE_OK)
+            exit(1);
+        lept_free(&v);
+        count++;
+        p = eol + 1;
+    }
+    return count;
+}
+
+static double bench_lines_stream(const char* json, size_t length) {
+    lept_stream s;
+    lept_value v;
+    size_t count = 0;
+    int ret;
+    lept_stream_init(&s, json, length);
+    while ((ret = lept_stream_next(&s, &v)) == LEPT_PARSE_OK) {
+        lept_free(&v);
+        count++;
+    }
+    lept_stream_free(&s);
+    if (ret != LEPT_STREAM_END)
+        exit(1);
+    return count;
+}
+
+static void bench_stream() {
+    size_t length;
+    char* json = bench_lines(50000, &length);
+    bench_result("JSON Lines, lept_parse_n per line", bench_lines_parse_n, json, length, 50000);
+    bench_result("JSON Lines, lept_stream", bench_lines_stream, json, length, 50000);
+    free(json);
+}
+
+static int bench_count_line(void* ctx, size_t offset, int ret, lept_value* v) {
+    (void)offset;
+    (void)v;
+    if (ret != LEPT_PARSE_OK)
+        return 1;
+    ++*(size_t*)ctx;
+    return 0;
+}
+
+/* Wall-clock seconds; clock() adds up the CPU time of all threads. */
+static double bench_wall() {
+#ifdef CLOCK_MONOTONIC
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+#else
+    return (double)time(NULL);
+#endif
+}
+
+static void bench_parse_lines(const char* json, size_t length, unsigned threads) {
+    char name[64];
+    size_t n = 0;
+    clock_t start = clock();
+    double begin = bench_wall(), wall;
+    do {
+        size_t count = 0;
+        if (lept_parse_lines(json, length, threads, bench_count_line, &count) != 0 || count != 200000) {
+            fprintf(stderr, "lept_parse_lines: wrong result\n");
+            exit(1);
+        }
+        n++;
+    } while ((wall = bench_wall() - begin) < BENCH_MIN_SECONDS * 2);
+    sprintf(name, "JSON Lines, %u thread%s", threads, threads > 1 ? "s" : "");
+    printf("%-36s %10.1f MB/s  %8.3f ms/iter  (%.1f CPUs busy)\n", name,
+        length * (double)n / wall / 1e6, wall * 1e3 / n, (double)(clock() - start) / CLOCKS_PER_SEC / wall);
+}
+
+static void bench_lines_scaling() {
+    static const unsigned threads[] = { 1, 2, 4, 8 };
+    size_t length, i;
+    char* json = bench_lines(200000, &length);
+    for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+        bench_parse_lines(json, length, threads[i]);
+    free(json);
+}
+
+static int bench_read_file(const char* path, lept_value* v) {
+    FILE* f = fopen(path, "rb");
+    char* json;
+    long len;
+    int ret;
+    if (f == NULL)
+        exit(1);
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    json = (char*)malloc(len + 1);
+    if (fread(json, 1, len, f) != (size_t)len)
+        exit(1);
+    fclose(f);
+    json[len] = '\0';
+    ret = lept_parse_n(v, json, len);
+    free(json);
+    return ret;
+}
+
+static int bench_parse_file_once(void* ctx) {
+    const bench_input* in = (const bench_input*)ctx;
+    lept_value v;
+    int ret = in->flags == (unsigned)-1 ? bench_read_file(in->json, &v) : lept_parse_file(&v, in->json, in->flags);
+    if (ret == LEPT_PARSE_OK)
+        lept_free(&v);
+    return ret;
+}
+
+/* With flags (unsigned)-1 the file is read with fread() and parsed with lept_parse_n(). */
+static void bench_parse_file(const char* name, const char* path, size_t length, unsigned flags) {
+    bench_input in;
+    bench_input_init(&in, path, length);
+    in.flags = flags;
+    bench_run(name, length, bench_parse_file_once, &in);
+}
+
+static void bench_file() {
+    const char* path = "leptjson_bench.json";
+    size_t length;
+    char* json = bench_records(100000, 2, &length);
+    FILE* f = fopen(path, "wb");
+    if (f == NULL)
+        return;
+    fwrite(json, 1, length, f);
+    fclose(f);
+    free(json);
+    bench_parse_file("fread + lept_parse_n", path, length, (unsigned)-1);
+    bench_parse_file("lept_parse_file", path, length, 0);
+    bench_parse_file("lept_parse_file, populate", path, length, LEPT_PARSE_FLAG_POPULATE);
+    remove(path);
+}
+
+static int bench_validate_once(void* ctx) {
+    const bench_input* in = (const bench_input*)ctx;
+    return lept_validate(in->json, in->length, NULL);
+}
+
+static void bench_validate_n(const char* name, const char* json, size_t length) {
+    bench_input in;
+    bench_input_init(&in, json, length);
+    bench_run(name, length, bench_validate_once, &in);
+}
+
+static void bench_validate() {
+    size_t length;
+    char* json;
+    json = bench_records(20000, 0, &length);
+    bench_parse_ex("parse records", json, length, 0);
+    bench_validate_n("validate records", json, length);
+    free(json);
+    json = bench_strings(5000, 256, &length);
+    bench_parse_ex("parse strings (256 bytes)", json, length, 0);
+    bench_validate_n("validate strings (256 bytes)", json, length);
+    free(json);
+    json = bench_numbers(100000, &length);
+    bench_parse_ex("parse numbers", json, length, 0);
+    bench_validate_n("validate numbers", json, length);
+    free(json);
+}
+
+/* An array of `count` strings of mixed-width UTF-8 text, unescaped. */
+static char* bench_utf8_text(size_t count, size_t* length) {
+    static const char* words[] = { "caf\xC3\xA9 ", "na\xC3\xAFve ", "\xE6\xBC\xA2\xE5\xAD\x97 ", "\xF0\x9F\x98\x80 ", "plain " };
+    bench_buffer b = { NULL, 0, 0 };
+    size_t i, k;
+    APPENDS(&b, "[");
+    for (i = 0; i < count; i++) {
+        APPENDS(&b, i > 0 ? ",\"" : "\"");
+        for (k = 0; k < 24; k++)
+            APPENDS(&b, words[(i + k * 3) % 5]);
+        APPENDS(&b, "\"");
+    }
+    APPENDS(&b, "]");
+    *length = b.size;
+    return b.json;
+}
+
+static void bench_utf8() {
+    size_t length;
+    char* json;
+    json = bench_records(20000, 0, &length);
+    bench_parse_ex("parse records", json, length, 0);
+    bench_parse_ex("parse records, UTF-8 checked", json, length, LEPT_PARSE_FLAG_VALIDATE_UTF8);
+    free(json);
+    json = bench_strings(5000, 256, &length);
+    bench_parse_ex("parse strings (256 bytes)", json, length, 0);
+    bench_parse_ex("parse strings (256), UTF-8 checked", json, length, LEPT_PARSE_FLAG_VALIDATE_UTF8);
+    free(json);
+    json = bench_utf8_text(5000, &length);
+    bench_parse_ex("parse UTF-8 text", json, length, 0);
+    bench_parse_ex("parse UTF-8 text, UTF-8 checked", json, length, LEPT_PARSE_FLAG_VALIDATE_UTF8);
+    free(json);
+}
+
+typedef struct {
+    const char* json;
+    size_t length;
+    lept_parser* p;
+    lept_writer* w;
+}bench_messages_input;
+
+/* A batch of 1000 messages. */
+static int bench_messages_once(void* ctx) {
+    const bench_messages_input* in = (const bench_messages_input*)ctx;
+    size_t i;
+    for (i = 0; i < 1000; i++) {
+        lept_value v;
+        int ret = in->p != NULL ? lept_parser_parse(in->p, &v, in->json, in->length, 0) : lept_parse_n(&v, in->json, in->length);
+        if (ret != LEPT_PARSE_OK)
+            return ret;
+        if (in->w != NULL)
+            lept_writer_stringify(in->w, &v, NULL);
+        else
+            free(lept_stringify(&v, NULL));
+        lept_free(&v);
+    }
+    return LEPT_PARSE_OK;
+}
+
+/* Many small messages, as a service sees them: a fresh context per call, or one kept. */
+static void bench_messages(const char* name, const char* json, size_t length, lept_parser* p, lept_writer* w) {
+    bench_messages_input in;
+    size_t n;
+    double seconds;
+    in.json = json;
+    in.length = length;
+    in.p = p;
+    in.w = w;
+    seconds = bench_time(name, bench_messages_once, &in, &n);
+    n *= 1000;
+    printf("%-36s %10.0f msg/s  %8.3f us/msg\n", name, n / seconds, seconds * 1e6 / n);
+}
+
+static void bench_reuse() {
+    const char* json = "{\"id\":42,\"user\":{\"name\":\"bench\",\"roles\":[\"a\",\"b\"]},\"timeout\":2.5,\"retries\":3,\"scale\":[1,2,3]}";
+    lept_parser* p = lept_parser_create();
+    lept_writer* w = lept_writer_create();
+    bench_messages("small messages, parse + stringify", json, strlen(json), NULL, NULL);
+    bench_messages("small messages, parser + writer", json, strlen(json), p, w);
+    lept_parser_free(p);
+    lept_writer_free(w);
+}
+
+static int bench_parse_document_once(void* ctx) {
+    const bench_input* in = (const bench_input*)ctx;
+    lept_document* d = (lept_document*)in->state;
+    int ret;
+    if ((ret = lept_document_parse(d, in->json, in->length, in->flags)) == LEPT_PARSE_OK)
+        lept_document_reset_unchanged(d);
+    return ret;
+}
+
+static void bench_parse_document(const char* name, const char* json, size_t length, unsigned flags) {
+    bench_input in;
+    bench_input_init(&in, json, length);
+    in.flags = flags;
+    in.state = lept_document_create();
+    bench_run(name, length, bench_parse_document_once, &in);
+    lept_document_free((lept_document*)in.state);
+}
+
+static void bench_document() {
+    size_t length;
+    char* json;
+    json = bench_records(20000, 0, &length);
+    bench_parse_ex("parse records + free", json, length, 0);
+    bench_parse_document("parse records to document + reset", json, length, 0);
+    free(json);
+    json = bench_strings(20000, 16, &length);
+    bench_parse_ex("parse strings (16 bytes) + free", json, length, 0);
+    bench_parse_document("parse strings (16) to document", json, length, 0);
+    free(json);
+}
+
+typedef struct {
+    lept_value* v;
+    const char* key;
+    size_t klen;
+    double sum;     /* of the values found, so that the lookups are not optimized away */
+}bench_lookup;
+
+static int bench_find_field_once(void* ctx) {
+    bench_lookup* l = (bench_lookup*)ctx;
+    size_t i, size = lept_get_array_size(l->v);
+    for (i = 0; i < size; i++)
+        l->sum += lept_get_number(lept_find_object_value(lept_get_array_element(l->v, i), l->key, l->klen));
+    return LEPT_PARSE_OK;
+}
+
+/* Field lookups in every record, by the key's text or by its interned copy. */
+static void bench_find_field(const char* name, lept_document* d, const char* key) {
+    bench_lookup l;
+    size_t n, size;
+    double seconds;
+    l.v = lept_document_root(d);
+    l.key = key;
+    l.klen = strlen(key);
+    l.sum = 0.0;
+    size = lept_get_array_size(l.v);
+    seconds = bench_time(name, bench_find_field_once, &l, &n);
+    printf("%-36s %10.1f ns/lookup  (%.0f)\n", name, seconds * 1e9 / ((double)n * size), l.sum / n);
+}
+
+static void bench_intern_keys() {
+    size_t length;
+    char* json = bench_records(20000, 0, &length);
+    lept_document* d = lept_document_create();
+    bench_parse_document("parse records to document", json, length, 0);
+    bench_parse_document("parse records to document, interned", json, length, LEPT_PARSE_FLAG_INTERN_KEYS);
+    lept_document_parse(d, json, length, LEPT_PARSE_FLAG_INTERN_KEYS);
+    bench_find_field("find \"score\" by text", d, "score");
+    bench_find_field("find \"score\" by interned key", d, lept_document_find_key(d, "score", 5));
+    lept_document_free(d);
+    free(json);
+}
+
+/* Large arrays: with the index each container is allocated once, at its size. */
+static void bench_exact_size() {
+    size_t length;
+    char* json = bench_records(200000, 0, &length);
+    bench_parse_ex("parse 200k records", json, length, 0);
+    bench_parse_ex("parse 200k records indexed", json, length, LEPT_PARSE_FLAG_INDEXED);
+    free(json);
+    json = bench_numbers(2000000, &length);
+    bench_parse_ex("parse 2M numbers", json, length, 0);
+    bench_parse_ex("parse 2M numbers indexed", json, length, LEPT_PARSE_FLAG_INDEXED);
+    free(json);
+}
+
+static void bench_insitu() {
+    size_t length;
+    char* json;
+    json = bench_records(20000, 0, &length);
+    bench_parse("parse records", json, length);
+    bench_parse_insitu("parse records in situ", json, length);
+    free(json);
+    json = bench_strings(20000, 16, &length);
+    bench_parse("parse strings (16 bytes)", json, length);
+    bench_parse_insitu("parse strings (16 bytes) in situ", json, length);
+    free(json);
+}
+
+typedef struct {
+    lept_value v;
+    char** keys;
+    size_t n, count;    /* members, lookups so far */
+    double sum;
+}bench_object_keys;
+
+/* A batch of 1024 lookups between clock() calls. */
+static int bench_object_lookup_once(void* ctx) {
+    bench_object_keys* o = (bench_object_keys*)ctx;
+    size_t i;
+    for (i = 0; i < 1024; i++, o->count++)
+        o->sum += lept_get_number(lept_find_object_value(&o->v, o->keys[o->count % o->n], strlen(o->keys[o->count % o->n])));
+    return LEPT_PARSE_OK;
+}
+
+/* lept_find_object_value() on every key of an object of n members, in turn. */
+static void bench_object_lookup(size_t n) {
+    bench_buffer b = { NULL, 0, 0 };
+    bench_object_keys o;
+    char name[64], key[16];
+    size_t i, batches;
+    double seconds;
+    o.keys = (char**)malloc(n * sizeof(char*));
+    o.n = n;
+    o.count = 0;
+    o.sum = 0.0;
+    APPENDS(&b, "{");
+    for (i = 0; i < n; i++) {
+        sprintf(key, "field_%lu", (unsigned long)(i * 7919 % 100003));
+        o.keys[i] = (char*)malloc(strlen(key) + 1);
+        strcpy(o.keys[i], key);
+        APPENDS(&b, i > 0 ? ",\"" : "\"");
+        APPENDS(&b, key);
+        APPENDS(&b, "\":1");
+    }
+    APPENDS(&b, "}");
+    lept_init(&o.v);
+    if (lept_parse_n(&o.v, b.json, b.size) != LEPT_PARSE_OK) {
+        fprintf(stderr, "object lookup: parse error\n");
+        exit(1);
+    }
+    lept_index_object(&o.v);
+    sprintf(name, "find in object of %lu members", (unsigned long)n);
+    seconds = bench_time(name, bench_object_lookup_once, &o, &batches);
+    printf("%-36s %10.1f ns/lookup  (%.0f)\n", name, seconds * 1e9 / o.count, o.sum / o.count);
+    for (i = 0; i < n; i++)
+        free(o.keys[i]);
+    free(o.keys);
+    free(b.json);
+    lept_free(&o.v);
+}
+
+/* Large objects are searched through the hash index of lept_index_object() (LEPT_OBJECT_INDEX_MIN). */
+static void bench_object_index() {
+    static const size_t sizes[] = { 4, 8, 12, 16, 24, 32, 64, 1000, 10000 };
+    size_t i;
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+        bench_object_lookup(sizes[i]);
+}
+
+/* Bytes held by a parsed tree: values, children blocks, strings and keys (allocator overhead aside). */
+static size_t bench_tree_bytes(lept_value* v) {
+    size_t i, n, bytes = 0;
+#ifdef LEPT_COMPACT_VALUE
+    const size_t header = sizeof(uint64_t);
+#else
+    const size_t header = 0;
+#endif
+    switch (lept_get_type(v)) {
+        case LEPT_STRING:
+            if (!(v->flags & LEPT_FLAG_INLINE))
+                bytes += lept_get_string_length(v) + 1;
+            break;
+        case LEPT_ARRAY:
+            n = lept_get_array_capacity(v);
+            bytes += n > 0 ? header + n * sizeof(lept_value) : 0;
+            for (i = 0; i < lept_get_array_size(v); i++)
+                bytes += bench_tree_bytes(lept_get_array_element(v, i));
+            break;
+        case LEPT_OBJECT:
+            n = lept_get_object_size(v);
+            bytes += n > 0 ? header + n * sizeof(lept_member) : 0;
+            for (i = 0; i < n; i++)
+                bytes += lept_get_object_key_length(v, i) + 1 + bench_tree_bytes(lept_get_object_value(v, i));
+            break;
+        default: break;
+    }
+    return bytes;
+}
+
+static void bench_tree_memory(const char* name, const char* json, size_t length) {
+    lept_value v;
+    size_t bytes;
+    lept_init(&v);
+    if (lept_parse_n(&v, json, length) != LEPT_PARSE_OK) {
+        fprintf(stderr, "%s: parse error\n", name);
+        exit(1);
+    }
+    bytes = sizeof(lept_value) + bench_tree_bytes(&v);
+    printf("%-36s %10.2f MB  %6.2f bytes per input byte\n", name, bytes / 1e6, (double)bytes / length);
+    lept_free(&v);
+}
+
+/* Footprint of the value layout; build with -DLEPT_COMPACT_VALUE to compare. */
+static void bench_memory() {
+    size_t length;
+    char* json;
+    printf("sizeof(lept_value) = %u, sizeof(lept_member) = %u\n", (unsigned)sizeof(lept_value), (unsigned)sizeof(lept_member));
+    json = bench_numbers(1000000, &length);
+    bench_tree_memory("tree of 1M numbers", json, length);
+    free(json);
+    json = bench_records(200000, 0, &length);
+    bench_tree_memory("tree of 200k records", json, length);
+    bench_parse_ex("parse 200k records", json, length, 0);
+    free(json);
+}
+
+/* Duplicate-key checks: a scan in small objects, a hash table on the parse stack in large ones. */
+static void bench_duplicates() {
+    bench_buffer b = { NULL, 0, 0 };
+    char buf[32];
+    size_t i, length;
+    char* json = bench_records(20000, 0, &length);
+    bench_parse_ex("parse records", json, length, 0);
+    bench_parse_ex("parse records, reject duplicates", json, length, LEPT_PARSE_FLAG_DUPLICATES_REJECT);
+    bench_parse_ex("parse records, last duplicate wins", json, length, LEPT_PARSE_FLAG_DUPLICATES_LAST);
+    free(json);
+    APPENDS(&b, "{");
+    for (i = 0; i < 100000; i++) {
+        sprintf(buf, "%s\"key%lu\":%lu", i > 0 ? "," : "", (unsigned long)i, (unsigned long)i);
+        APPENDS(&b, buf);
+    }
+    APPENDS(&b, "}");
+    bench_parse_ex("parse object of 100k members", b.json, b.size, 0);
+    bench_parse_ex("parse 100k members, reject dups", b.json, b.size, LEPT_PARSE_FLAG_DUPLICATES_REJECT);
+    free(b.json);
+}
+
+int main() {
+#if defined(__AVX2__) && !defined(LEPT_NO_SIMD)
+    printf("leptjson built with AVX2\n");
+#elif (defined(__SSE2__) || defined(_M_X64)) && !defined(LEPT_NO_SIMD)
+    printf("leptjson built with SSE2\n");
+#else
+    printf("leptjson built without SIMD\n");
+#endif
+    bench_whitespace();
+    bench_string();
+    bench_insitu();
+    bench_number();
+    bench_nesting();
+    bench_indexed();
+    bench_tape();
+    bench_on_demand();
+    bench_sax();
+    bench_push();
+    bench_stream();
+    bench_lines_scaling();
+    bench_file();
+    bench_validate();
+    bench_utf8();
+    bench_reuse();
+    bench_document();
+    bench_exact_size();
+    bench_intern_keys();
+    bench_memory();
+    bench_object_index();
+    bench_duplicates();
+    return 0;
+}
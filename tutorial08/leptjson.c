@@ -1,14 +1,67 @@
+#if !defined(LEPT_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define LEPT_MMAP
+#define _DEFAULT_SOURCE /* mmap(), madvise() */
+#endif
 #ifdef _WINDOWS
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
 #endif
 #include "leptjson.h"
 #include <assert.h>  /* assert() */
-#include <errno.h>   /* errno, ERANGE */
 #include <math.h>    /* HUGE_VAL */
 #include <stdio.h>   /* sprintf() */
-#include <stdlib.h>  /* NULL, malloc(), realloc(), free(), strtod() */
-#include <string.h>  /* memcpy() */
+#include <stdint.h>  /* uint64_t */
+#include <stdlib.h>  /* NULL, malloc(), realloc(), free() */
+#include <string.h>  /* memcpy(), strlen() */
+#ifdef LEPT_THREADS
+#include <pthread.h>
+#endif
+#ifdef LEPT_MMAP
+#include <fcntl.h>     /* open() */
+#include <sys/mman.h>  /* mmap(), madvise() */
+#include <sys/stat.h>  /* fstat() */
+#include <unistd.h>    /* close(), sysconf() */
+#endif
+
+#ifndef LEPT_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEPT_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__) || defined(__AVX2__)
+#define LEPT_SSSE3
+#include <tmmintrin.h>
+#endif
+#ifdef __AVX2__
+#define LEPT_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+/*
+ * The SIMD scanners read whole aligned blocks that may run past the end of
+ * the input; that is safe (an aligned block never crosses a page) but
+ * AddressSanitizer reports it, so those loads are left uninstrumented.
+ */
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define LEPT_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#endif
+#elif defined(__SANITIZE_ADDRESS__)
+#define LEPT_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#endif
+#ifndef LEPT_NO_SANITIZE_ADDRESS
+#define LEPT_NO_SANITIZE_ADDRESS
+#endif
+
+#if defined(LEPT_SSE2) || defined(LEPT_AVX2)
+#ifdef _MSC_VER
+#include <intrin.h>
+static unsigned lept_ctz(unsigned m) { unsigned long i; _BitScanForward(&i, m); return (unsigned)i; }
+#else
+#define lept_ctz(m) ((unsigned)__builtin_ctz(m))
+#endif
+#endif
 
 #ifndef LEPT_PARSE_STACK_INIT_SIZE
 #define LEPT_PARSE_STACK_INIT_SIZE 256
@@ -18,324 +71,3951 @@
 #define LEPT_PARSE_STRINGIFY_INIT_SIZE 256
 #endif
 
-#define EXPECT(c, ch)       do { assert(*c->json == (ch)); c->json++; } while(0)
-#define ISDIGIT(ch)         ((ch) >= '0' && (ch) <= '9')
-#define ISDIGIT1TO9(ch)     ((ch) >= '1' && (ch) <= '9')
-#define PUTC(c, ch)         do { *(char*)lept_context_push(c, sizeof(char)) = (ch); } while(0)
-#define PUTS(c, s, len)     memcpy(lept_context_push(c, len), s, len)
+/* First block of a lept_document's arena; each further block doubles. */
+#ifndef LEPT_DOCUMENT_BLOCK_SIZE
+#define LEPT_DOCUMENT_BLOCK_SIZE 4096
+#endif
+
+/* Interned keys a lept_document keeps from one parse to the next. */
+#ifndef LEPT_DOCUMENT_KEYS_KEEP
+#define LEPT_DOCUMENT_KEYS_KEEP 4096
+#endif
+
+/* lept_index_object() builds a hash index for objects of this many members. */
+#ifndef LEPT_OBJECT_INDEX_MIN
+#define LEPT_OBJECT_INDEX_MIN 16
+#endif
+
+/* Default stack capacity a lept_parser or lept_writer keeps between calls. */
+#ifndef LEPT_PARSE_STACK_KEEP_SIZE
+#define LEPT_PARSE_STACK_KEEP_SIZE 65536
+#endif
+
+/*
+ * Value fields that differ between the two layouts. With LEPT_COMPACT_VALUE
+ * one 32-bit size serves strings, arrays and objects, and the capacity of an
+ * array or object sits in a header just before its first child.
+ * TOO_BIG(n) tells whether a length or count does not fit that size.
+ */
+#ifdef LEPT_COMPACT_VALUE
+#define ASIZE(v)                (v)->size
+#define OSIZE(v)                (v)->size
+#define SLEN(v)                 (v)->size
+#define INLINE_LEN(v)           (v)->size
+#define SET_INLINE_LEN(v, len)  ((v)->size = (uint32_t)(len))
+#define CHILD_HEADER            sizeof(uint64_t)
+#define CAPACITY(e)             ((e) != NULL ? (size_t)((const uint64_t*)(e))[-1] : 0)
+#define ACAPACITY(v)            CAPACITY((v)->u.a.e)
+#define OCAPACITY(v)            CAPACITY((v)->u.o.m)
+#define SET_ACAPACITY(v, n)     ((void)(n)) /* in the children's header */
+#define SET_OCAPACITY(v, n)     ((void)(n))
+#define TOO_BIG(n)              ((n) > UINT32_MAX)
+#else
+#define ASIZE(v)                (v)->u.a.size
+#define OSIZE(v)                (v)->u.o.size
+#define SLEN(v)                 (v)->u.s.len
+#define INLINE_LEN(v)           ((unsigned char)(v)->u.ss[sizeof((v)->u.ss) - 1])
+#define SET_INLINE_LEN(v, len)  ((v)->u.ss[sizeof((v)->u.ss) - 1] = (char)(len))
+#define CHILD_HEADER            0
+#define ACAPACITY(v)            (v)->u.a.capacity
+#define OCAPACITY(v)            (v)->u.o.capacity
+#define SET_ACAPACITY(v, n)     ((v)->u.a.capacity = (n))
+#define SET_OCAPACITY(v, n)     ((v)->u.o.capacity = (n))
+#define TOO_BIG(n)              0
+#endif
+
+#define EXPECT(c, ch)       do { assert(*c->json == (ch)); c->json++; } while(0)
+#define ISWS(ch)            ((ch) == ' ' || (ch) == '\t' || (ch) == '\n' || (ch) == '\r')
+#define ISSPECIAL(ch)       ((ch) == '"' || (ch) == '\\' || (unsigned char)(ch) < 0x20)
+#define ISDIGIT(ch)         ((ch) >= '0' && (ch) <= '9')
+#define ISDIGIT1TO9(ch)     ((ch) >= '1' && (ch) <= '9')
+#define PUTC(c, ch)         do { *(char*)lept_context_push(c, sizeof(char)) = (ch); } while(0)
+#define PUTS(c, s, len)     memcpy(lept_context_push(c, len), s, len)
+#define AT(c, p)            ((p) < (c)->end ? *(p) : '\0')  /* '\0' stands for end of input */
+#define PEEK(c)             AT(c, (c)->json)
+
+#define LEPT_FLAG_INTEGER   (LEPT_FLAG_INT64 | LEPT_FLAG_UINT64)
+
+/* A bump allocator over a list of blocks, freed all at once. */
+typedef struct lept_arena_block {
+    struct lept_arena_block* next;
+    size_t size;        /* bytes following this header */
+}lept_arena_block;
+
+typedef struct {
+    lept_arena_block* head; /* the current block, then older ones */
+    char* p, *end;          /* free space left in head */
+    size_t total;           /* bytes in all blocks */
+}lept_arena;
+
+typedef struct {
+    const char* k;  /* NULL in a free slot */
+    size_t klen;
+    uint32_t hash;
+}lept_key_slot;
+
+/* Interned keys: one copy of each distinct key, in an arena of its own. */
+typedef struct {
+    lept_arena arena;
+    lept_key_slot* slots;   /* open addressing, capacity a power of two */
+    size_t capacity, count;
+}lept_keys;
+
+typedef struct {
+    const char* json;
+    const char* end;
+    int padded;     /* LEPT_PARSE_PADDING readable bytes follow end */
+    char* stack;
+    size_t size, top;
+    int insitu;     /* decode strings in place into the mutable source buffer */
+    int utf8;       /* LEPT_PARSE_FLAG_VALIDATE_UTF8 */
+    char* dst;      /* in-situ write position of the string being decoded */
+    lept_arena* arena;  /* if set, the tree is allocated here and borrowed */
+    lept_keys* keys;    /* with arena: keys are interned here instead */
+    unsigned duplicates;    /* LEPT_PARSE_FLAG_DUPLICATES_*, or 0 to keep every member */
+    size_t frame;   /* stack offset of the innermost open container */
+    size_t depth, max_depth;
+    const uint32_t* index;  /* structural index of the input from begin, or NULL */
+    const char* begin;
+    size_t ipos;            /* first index entry that may lie at or after json */
+    const uint32_t* sizes;  /* with the index: child count of each container, in opening order */
+    size_t nsizes, isize;   /* isize: the next container to open */
+}lept_context;
+
+static void* lept_context_push(lept_context* c, size_t size) {
+    void* ret;
+    assert(size > 0);
+    if (c->top + size >= c->size) {
+        if (c->size == 0)
+            c->size = LEPT_PARSE_STACK_INIT_SIZE;
+        while (c->top + size >= c->size)
+            c->size += c->size >> 1;  /* c->size * 1.5 */
+        c->stack = (char*)realloc(c->stack, c->size);
+    }
+    ret = c->stack + c->top;
+    c->top += size;
+    return ret;
+}
+
+static void* lept_context_pop(lept_context* c, size_t size) {
+    assert(c->top >= size);
+    return c->stack + (c->top -= size);
+}
+
+typedef struct {
+    char* p;
+    size_t size, top;
+}lept_buffer;
+
+static void* lept_buffer_push(lept_buffer* b, size_t size) {
+    void* ret;
+    if (b->top + size > b->size) {
+        if (b->size == 0)
+            b->size = LEPT_PARSE_STACK_INIT_SIZE;
+        while (b->top + size > b->size)
+            b->size += b->size >> 1;  /* b->size * 1.5 */
+        b->p = (char*)realloc(b->p, b->size);
+    }
+    ret = b->p + b->top;
+    b->top += size;
+    return ret;
+}
+
+static void* lept_arena_alloc(lept_arena* a, size_t size, size_t align) {
+    char* p = (char*)(((size_t)a->p + align - 1) & ~(align - 1));
+    if (a->head == NULL || p > a->end || size > (size_t)(a->end - p)) {
+        size_t bsize = a->head != NULL ? a->head->size * 2 : LEPT_DOCUMENT_BLOCK_SIZE;
+        lept_arena_block* b;
+        while (bsize < size)
+            bsize *= 2;
+        b = (lept_arena_block*)malloc(sizeof(lept_arena_block) + bsize);
+        b->next = a->head;
+        b->size = bsize;
+        a->head = b;
+        a->total += bsize;
+        p = (char*)(b + 1);
+        a->end = p + bsize;
+    }
+    a->p = p + size;
+    return p;
+}
+
+static void lept_arena_free(lept_arena* a) {
+    while (a->head != NULL) {
+        lept_arena_block* next = a->head->next;
+        free(a->head);
+        a->head = next;
+    }
+    a->p = a->end = NULL;
+    a->total = 0;
+}
+
+/* Empties the arena, keeping one block as large as all of them were. */
+static void lept_arena_reset(lept_arena* a) {
+    size_t total = a->total;
+    if (a->head != NULL && a->head->next != NULL) {
+        lept_arena_free(a);
+        lept_arena_alloc(a, total, 1);
+    }
+    if (a->head != NULL)
+        a->p = (char*)(a->head + 1);
+}
+
+/* A copy of s in the arena. */
+static char* lept_arena_string(lept_arena* a, const char* s, size_t len) {
+    char* p = (char*)lept_arena_alloc(a, len + 1, 1);
+    memcpy(p, s, len);
+    p[len] = '\0';
+    return p;
+}
+
+/* FNV-1a */
+static uint32_t lept_hash(const char* s, size_t len) {
+    uint32_t h = 2166136261u;
+    size_t i;
+    for (i = 0; i < len; i++)
+        h = (h ^ (unsigned char)s[i]) * 16777619u;
+    return h;
+}
+
+static void lept_keys_grow(lept_keys* t) {
+    size_t capacity = t->capacity ? t->capacity * 2 : 64, i, j;
+    lept_key_slot* slots = (lept_key_slot*)calloc(capacity, sizeof(lept_key_slot));
+    for (i = 0; i < t->capacity; i++)
+        if (t->slots[i].k != NULL) {
+            for (j = t->slots[i].hash & (capacity - 1); slots[j].k != NULL; j = (j + 1) & (capacity - 1))
+                ;
+            slots[j] = t->slots[i];
+        }
+    free(t->slots);
+    t->slots = slots;
+    t->capacity = capacity;
+}
+
+/* The one copy of k in t, added if it is new. */
+static char* lept_keys_intern(lept_keys* t, const char* k, size_t klen) {
+    uint32_t h = lept_hash(k, klen);
+    size_t i;
+    if (2 * (t->count + 1) > t->capacity)
+        lept_keys_grow(t);
+    for (i = h & (t->capacity - 1); t->slots[i].k != NULL; i = (i + 1) & (t->capacity - 1))
+        if (t->slots[i].hash == h && t->slots[i].klen == klen && memcmp(t->slots[i].k, k, klen) == 0)
+            return (char*)t->slots[i].k;
+    t->slots[i].k = lept_arena_string(&t->arena, k, klen);
+    t->slots[i].klen = klen;
+    t->slots[i].hash = h;
+    t->count++;
+    return (char*)t->slots[i].k;
+}
+
+static const char* lept_keys_find(const lept_keys* t, const char* k, size_t klen) {
+    uint32_t h = lept_hash(k, klen);
+    size_t i;
+    if (t->count == 0)
+        return NULL;
+    for (i = h & (t->capacity - 1); t->slots[i].k != NULL; i = (i + 1) & (t->capacity - 1))
+        if (t->slots[i].hash == h && t->slots[i].klen == klen && memcmp(t->slots[i].k, k, klen) == 0)
+            return t->slots[i].k;
+    return NULL;
+}
+
+static void lept_keys_clear(lept_keys* t) {
+    if (t->count != 0)
+        memset(t->slots, 0, t->capacity * sizeof(lept_key_slot));
+    t->count = 0;
+    lept_arena_reset(&t->arena);
+}
+
+static void lept_keys_free(lept_keys* t) {
+    free(t->slots);
+    lept_arena_free(&t->arena);
+    memset(t, 0, sizeof(lept_keys));
+}
+
+/*
+ * High-water mark policy of reusable stacks: one grown past keep bytes by a
+ * large text goes back to keep, so a single outlier does not pin its memory.
+ */
+static void lept_stack_trim(char** stack, size_t* size, size_t keep) {
+    if (*size <= keep)
+        return;
+    if (keep < LEPT_PARSE_STACK_INIT_SIZE) {
+        free(*stack);
+        *stack = NULL;
+        *size = 0;
+    }
+    else
+        *stack = (char*)realloc(*stack, *size = keep);
+}
+
+/*
+ * SIMD block classifiers: bit i of the result is set when p[i] stops the scan.
+ *
+ * Unless the input is padded (LEPT_PARSE_FLAG_PADDED), scanners only load
+ * blocks that start on a LEPT_SIMD_BLOCK boundary below c->end, so a load
+ * never touches a page that holds no input byte. Bits for bytes at or past
+ * c->end are ignored.
+ */
+#if defined(LEPT_AVX2)
+#define LEPT_SIMD_BLOCK 32
+LEPT_NO_SANITIZE_ADDRESS static unsigned lept_mask_nonws(const char* p) {
+    const __m256i s = _mm256_loadu_si256((const __m256i*)p);
+    __m256i x = _mm256_or_si256(_mm256_cmpeq_epi8(s, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(s, _mm256_set1_epi8('\n')));
+    x = _mm256_or_si256(x, _mm256_or_si256(_mm256_cmpeq_epi8(s, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(s, _mm256_set1_epi8('\t'))));
+    return ~(unsigned)_mm256_movemask_epi8(x);
+}
+
+LEPT_NO_SANITIZE_ADDRESS static unsigned lept_mask_special(const char* p) {
+    const __m256i s = _mm256_loadu_si256((const __m256i*)p);
+    __m256i x = _mm256_or_si256(_mm256_cmpeq_epi8(s, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(s, _mm256_set1_epi8('\\')));
+    x = _mm256_or_si256(x, _mm256_cmpeq_epi8(_mm256_min_epu8(s, _mm256_set1_epi8(0x1F)), s)); /* s <= 0x1F */
+    return (unsigned)_mm256_movemask_epi8(x);
+}
+#elif defined(LEPT_SSE2)
+#define LEPT_SIMD_BLOCK 16
+LEPT_NO_SANITIZE_ADDRESS static unsigned lept_mask_nonws(const char* p) {
+    const __m128i s = _mm_loadu_si128((const __m128i*)p);
+    __m128i x = _mm_or_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(s, _mm_set1_epi8('\n')));
+    x = _mm_or_si128(x, _mm_or_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(s, _mm_set1_epi8('\t'))));
+    return (unsigned)_mm_movemask_epi8(x) ^ 0xFFFF;
+}
+
+LEPT_NO_SANITIZE_ADDRESS static unsigned lept_mask_special(const char* p) {
+    const __m128i s = _mm_loadu_si128((const __m128i*)p);
+    __m128i x = _mm_or_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8('"')), _mm_cmpeq_epi8(s, _mm_set1_epi8('\\')));
+    x = _mm_or_si128(x, _mm_cmpeq_epi8(_mm_min_epu8(s, _mm_set1_epi8(0x1F)), s)); /* s <= 0x1F */
+    return (unsigned)_mm_movemask_epi8(x);
+}
+#endif
+
+#ifdef LEPT_SIMD_BLOCK
+#define LEPT_ALIGNED(p)     (((size_t)(p) & (LEPT_SIMD_BLOCK - 1)) == 0)
+
+static const char* lept_skip_whitespace(const lept_context* c, const char* p) {
+    if (!c->padded)
+        for (; p < c->end && !LEPT_ALIGNED(p); p++)
+            if (!ISWS(*p))
+                return p;
+    for (; p < c->end; p += LEPT_SIMD_BLOCK) {
+        unsigned m = lept_mask_nonws(p);
+        if (m != 0)
+            return p + lept_ctz(m) < c->end ? p + lept_ctz(m) : c->end;
+    }
+    return c->end;
+}
+
+/* Returns the first '"', '\\' or control character at or after p, or c->end. */
+static const char* lept_scan_string(const lept_context* c, const char* p) {
+    if (!c->padded)
+        for (; p < c->end && !LEPT_ALIGNED(p); p++)
+            if (ISSPECIAL(*p))
+                return p;
+    for (; p < c->end; p += LEPT_SIMD_BLOCK) {
+        unsigned m = lept_mask_special(p);
+        if (m != 0)
+            return p + lept_ctz(m) < c->end ? p + lept_ctz(m) : c->end;
+    }
+    return c->end;
+}
+#else
+static const char* lept_skip_whitespace(const lept_context* c, const char* p) {
+    while (p < c->end && ISWS(*p))
+        p++;
+    return p;
+}
+
+static const char* lept_scan_string(const lept_context* c, const char* p) {
+    while (p < c->end && !ISSPECIAL(*p))
+        p++;
+    return p;
+}
+#endif
+
+/*
+ * UTF-8 validation of the raw bytes of a string, run span by span between
+ * escapes: escapes and quotes are ASCII, so a span must hold whole
+ * characters. Overlong forms, surrogates and code points above U+10FFFF
+ * are rejected. With SSSE3 or AVX2 this costs about 15-30% on string-heavy
+ * input, about 1% on records; the scalar fallback up to 3x on non-ASCII text.
+ */
+static int lept_utf8_valid_scalar(const unsigned char* p, const unsigned char* end) {
+    while (p < end) {
+        unsigned ch, lo = 0x80, hi = 0xBF;
+        size_t n, i;
+#ifdef LEPT_SSE2
+        if (end - p >= 16 && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p)) == 0) {
+            p += 16;
+            continue;
+        }
+#endif
+        if ((ch = *p++) < 0x80)
+            continue;
+        if (ch < 0xC2)
+            return 0;
+        else if (ch < 0xE0)
+            n = 1;
+        else if (ch < 0xF0) {
+            n = 2;
+            if (ch == 0xE0) lo = 0xA0;
+            if (ch == 0xED) hi = 0x9F;
+        }
+        else if (ch < 0xF5) {
+            n = 3;
+            if (ch == 0xF0) lo = 0x90;
+            if (ch == 0xF4) hi = 0x8F;
+        }
+        else
+            return 0;
+        if ((size_t)(end - p) < n || *p < lo || *p > hi)
+            return 0;
+        for (i = 1; i < n; i++)
+            if ((p[i] & 0xC0) != 0x80)
+                return 0;
+        p += n;
+    }
+    return 1;
+}
+
+#ifdef LEPT_SSSE3
+/*
+ * Keiser and Lemire's lookup algorithm, 16 bytes at a time: three table
+ * lookups on the nibbles of each byte and the byte before it classify every
+ * error of a two-byte window, and the bytes two and three back say where a
+ * continuation byte is required. Each bit below is one kind of error.
+ */
+#define LEPT_U8_TOO_SHORT   0x01
+#define LEPT_U8_TOO_LONG    0x02
+#define LEPT_U8_OVERLONG_3  0x04
+#define LEPT_U8_TOO_LARGE   0x08
+#define LEPT_U8_SURROGATE   0x10
+#define LEPT_U8_OVERLONG_2  0x20
+#define LEPT_U8_TOO_LARGE_1000 0x40
+#define LEPT_U8_OVERLONG_4  0x40
+#define LEPT_U8_TWO_CONTS   0x80
+#define LEPT_U8_CARRY       (LEPT_U8_TOO_SHORT | LEPT_U8_TOO_LONG | LEPT_U8_TWO_CONTS)
+
+typedef struct {
+    __m128i prev;       /* the previous block */
+    __m128i incomplete; /* non-zero where the previous block ends inside a character */
+    __m128i error;
+}lept_utf8_state;
+
+static void lept_utf8_block(lept_utf8_state* s, __m128i in) {
+    const __m128i lo4 = _mm_set1_epi8(0x0F);
+    __m128i prev1, prev2, prev3, sc, must23;
+    if (_mm_movemask_epi8(in) == 0) {
+        s->error = _mm_or_si128(s->error, s->incomplete);
+        s->prev = in;
+        s->incomplete = _mm_setzero_si128();
+        return;
+    }
+    prev1 = _mm_alignr_epi8(in, s->prev, 15);
+    sc = _mm_shuffle_epi8(_mm_setr_epi8(
+        /* 0xxx: ASCII; 10xx: continuation; 1100, 1101, 1110, 1111: lead of 2, 2, 3, 4 */
+        LEPT_U8_TOO_LONG, LEPT_U8_TOO_LONG, LEPT_U8_TOO_LONG, LEPT_U8_TOO_LONG,
+        LEPT_U8_TOO_LONG, LEPT_U8_TOO_LONG, LEPT_U8_TOO_LONG, LEPT_U8_TOO_LONG,
+        (char)LEPT_U8_TWO_CONTS, (char)LEPT_U8_TWO_CONTS, (char)LEPT_U8_TWO_CONTS, (char)LEPT_U8_TWO_CONTS,
+        LEPT_U8_TOO_SHORT | LEPT_U8_OVERLONG_2,
+        LEPT_U8_TOO_SHORT,
+        LEPT_U8_TOO_SHORT | LEPT_U8_OVERLONG_3 | LEPT_U8_SURROGATE,
+        LEPT_U8_TOO_SHORT | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000 | LEPT_U8_OVERLONG_4),
+        _mm_and_si128(_mm_srli_epi16(prev1, 4), lo4));
+    sc = _mm_and_si128(sc, _mm_shuffle_epi8(_mm_setr_epi8(
+        /* low nibble of the previous byte */
+        (char)(LEPT_U8_CARRY | LEPT_U8_OVERLONG_3 | LEPT_U8_OVERLONG_2 | LEPT_U8_OVERLONG_4),
+        (char)(LEPT_U8_CARRY | LEPT_U8_OVERLONG_2),
+        (char)LEPT_U8_CARRY, (char)LEPT_U8_CARRY,
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000 | LEPT_U8_SURROGATE),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000),
+        (char)(LEPT_U8_CARRY | LEPT_U8_TOO_LARGE | LEPT_U8_TOO_LARGE_1000)),
+        _mm_and_si128(prev1, lo4)));
+    sc = _mm_and_si128(sc, _mm_shuffle_epi8(_mm_setr_epi8(
+        /* high nibble of this byte: 0xxx, 1000, 1001, 101x, 11xx */
+        LEPT_U8_TOO_SHORT, LEPT_U8_TOO_SHORT, LEPT_U8_TOO_SHORT, LEPT_U8_TOO_SHORT,
+        LEPT_U8_TOO_SHORT, LEPT_U8_TOO_SHORT, LEPT_U8_TOO_SHORT, LEPT_U8_TOO_SHORT,
+        (char)(LEPT_U8_TOO_LONG | LEPT_U8_OVERLONG_2 | LEPT_U8_TWO_CONTS | LEPT_U8_OVERLONG_3 | LEPT_U8_TOO_LARGE_1000 | LEPT_U8_OVERLONG_4),
+        (char)(LEPT_U8_TOO_LONG | LEPT_U8_OVERLONG_2 | LEPT_U8_TWO_CONTS | LEPT_U8_OVERLONG_3 | LEPT_U8_TOO_LARGE),
+        (char)(LEPT_U8_TOO_LONG | LEPT_U8_OVERLONG_2 | LEPT_U8_TWO_CONTS | LEPT_U8_SURROGATE | LEPT_U8_TOO_LARGE),
+        (char)(LEPT_U8_TOO_LONG | LEPT_U8_OVERLONG_2 | LEPT_U8_TWO_CONTS | LEPT_U8_SURROGATE | LEPT_U8_TOO_LARGE),
+        LEPT_U8_TOO_SHORT, LEPT_U8_TOO_SHORT, LEPT_U8_TOO_SHORT, LEPT_U8_TOO_SHORT),
+        _mm_and_si128(_mm_srli_epi16(in, 4), lo4)));
+    /* a byte after the lead of a 3-byte (4-byte) character, two (three) bytes back, must continue it */
+    prev2 = _mm_alignr_epi8(in, s->prev, 14);
+    prev3 = _mm_alignr_epi8(in, s->prev, 13);
+    must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80)), _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80)));
+    must23 = _mm_and_si128(must23, _mm_set1_epi8((char)0x80));
+    s->error = _mm_or_si128(s->error, _mm_xor_si128(must23, sc));
+    s->incomplete = _mm_subs_epu8(in, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1)));
+    s->prev = in;
+}
+
+static int lept_utf8_valid(const char* p, const char* end) {
+    lept_utf8_state s;
+    char tail[16];
+    if (end - p < 16)
+        return lept_utf8_valid_scalar((const unsigned char*)p, (const unsigned char*)end);
+    s.prev = s.incomplete = s.error = _mm_setzero_si128();
+    for (; end - p >= 16; p += 16)
+        lept_utf8_block(&s, _mm_loadu_si128((const __m128i*)p));
+    /* the rest padded with ASCII, which also fails a character left incomplete */
+    memset(tail, 0, sizeof(tail));
+    memcpy(tail, p, end - p);
+    lept_utf8_block(&s, _mm_loadu_si128((const __m128i*)tail));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(s.error, _mm_setzero_si128())) == 0xFFFF;
+}
+#else
+static int lept_utf8_valid(const char* p, const char* end) {
+    return lept_utf8_valid_scalar((const unsigned char*)p, (const unsigned char*)end);
+}
+#endif
+
+/* With the structural index: the first entry at or after p, or c->end. */
+static const char* lept_index_seek(lept_context* c, const char* p) {
+    while (c->begin + c->index[c->ipos] < p)
+        c->ipos++;
+    return c->begin + c->index[c->ipos];
+}
+
+static void lept_parse_whitespace(lept_context* c) {
+    const char *p = c->json;
+    if (c->index != NULL) {
+        if (p < c->end && ISWS(*p))
+            c->json = lept_index_seek(c, p);
+        return;
+    }
+    /* minified JSON has no whitespace and a single space is common, so only long runs go to SIMD */
+    if (PEEK(c) != '\0' && ISWS(*p) && (++p, AT(c, p) != '\0' && ISWS(*p)))
+        p = lept_skip_whitespace(c, p + 1);
+    c->json = p;
+}
+
+static int lept_parse_literal(lept_context* c, lept_value* v, const char* literal, lept_type type) {
+    size_t i;
+    if (c->index != NULL) {
+        /* the token runs up to the next entry, less trailing whitespace */
+        const char* p = c->json, *e = lept_index_seek(c, p + 1), *q = e;
+        while (ISWS(q[-1]))
+            q--;
+        if ((size_t)(q - p) == strlen(literal) && memcmp(p, literal, q - p) == 0) {
+            c->json = e;
+            v->type = type;
+            return LEPT_PARSE_OK;
+        }
+    }
+    EXPECT(c, literal[0]);
+    for (i = 0; literal[i + 1]; i++)
+        if (AT(c, c->json + i) != literal[i + 1])
+            return LEPT_PARSE_INVALID_VALUE;
+    c->json += i;
+    v->type = type;
+    return LEPT_PARSE_OK;
+}
+
+/*
+ * Decimal to double conversion.
+ *
+ * lept_parse_number() collects up to 19 significant digits into a 64-bit
+ * mantissa w and a decimal exponent q while it validates the grammar, so the
+ * value is w * 10^q. Small exact cases are done with one floating-point
+ * operation (Clinger's fast path); the rest use the Eisel-Lemire algorithm,
+ * which multiplies w by a 128-bit approximation of 10^q and detects when the
+ * truncated product is too close to a rounding boundary to decide. Those
+ * rare cases, and results in the subnormal range, go to a slow path that
+ * shifts the decimal digits by powers of two (simple decimal conversion, as
+ * in Go's strconv); unlike strtod() it does not depend on the C locale.
+ */
+
+#define LEPT_U64(hi, lo) (((uint64_t)(hi) << 32) | (uint64_t)(lo))
+
+#define LEPT_POW10_MIN_EXP10 (-342)
+#define LEPT_POW10_MAX_EXP10 308
+
+/* 10^q normalized to [2^127, 2^128), truncated, as { high 64 bits, low 64 bits } */
+static const uint64_t lept_pow10_128[][2] = {
+    { LEPT_U64(0xEEF453D6, 0x923BD65A), LEPT_U64(0x113FAA29, 0x06A13B3F) }, /* 1e-342 */
+    { LEPT_U64(0x9558B466, 0x1B6565F8), LEPT_U64(0x4AC7CA59, 0xA424C507) }, /* 1e-341 */
+    { LEPT_U64(0xBAAEE17F, 0xA23EBF76), LEPT_U64(0x5D79BCF0, 0x0D2DF649) }, /* 1e-340 */
+    { LEPT_U64(0xE95A99DF, 0x8ACE6F53), LEPT_U64(0xF4D82C2C, 0x107973DC) }, /* 1e-339 */
+    { LEPT_U64(0x91D8A02B, 0xB6C10594), LEPT_U64(0x79071B9B, 0x8A4BE869) }, /* 1e-338 */
+    { LEPT_U64(0xB64EC836, 0xA47146F9), LEPT_U64(0x9748E282, 0x6CDEE284) }, /* 1e-337 */
+    { LEPT_U64(0xE3E27A44, 0x4D8D98B7), LEPT_U64(0xFD1B1B23, 0x08169B25) }, /* 1e-336 */
+    { LEPT_U64(0x8E6D8C6A, 0xB0787F72), LEPT_U64(0xFE30F0F5, 0xE50E20F7) }, /* 1e-335 */
+    { LEPT_U64(0xB208EF85, 0x5C969F4F), LEPT_U64(0xBDBD2D33, 0x5E51A935) }, /* 1e-334 */
+    { LEPT_U64(0xDE8B2B66, 0xB3BC4723), LEPT_U64(0xAD2C7880, 0x35E61382) }, /* 1e-333 */
+    { LEPT_U64(0x8B16FB20, 0x3055AC76), LEPT_U64(0x4C3BCB50, 0x21AFCC31) }, /* 1e-332 */
+    { LEPT_U64(0xADDCB9E8, 0x3C6B1793), LEPT_U64(0xDF4ABE24, 0x2A1BBF3D) }, /* 1e-331 */
+    { LEPT_U64(0xD953E862, 0x4B85DD78), LEPT_U64(0xD71D6DAD, 0x34A2AF0D) }, /* 1e-330 */
+    { LEPT_U64(0x87D4713D, 0x6F33AA6B), LEPT_U64(0x8672648C, 0x40E5AD68) }, /* 1e-329 */
+    { LEPT_U64(0xA9C98D8C, 0xCB009506), LEPT_U64(0x680EFDAF, 0x511F18C2) }, /* 1e-328 */
+    { LEPT_U64(0xD43BF0EF, 0xFDC0BA48), LEPT_U64(0x0212BD1B, 0x2566DEF2) }, /* 1e-327 */
+    { LEPT_U64(0x84A57695, 0xFE98746D), LEPT_U64(0x014BB630, 0xF7604B57) }, /* 1e-326 */
+    { LEPT_U64(0xA5CED43B, 0x7E3E9188), LEPT_U64(0x419EA3BD, 0x35385E2D) }, /* 1e-325 */
+    { LEPT_U64(0xCF42894A, 0x5DCE35EA), LEPT_U64(0x52064CAC, 0x828675B9) }, /* 1e-324 */
+    { LEPT_U64(0x818995CE, 0x7AA0E1B2), LEPT_U64(0x7343EFEB, 0xD1940993) }, /* 1e-323 */
+    { LEPT_U64(0xA1EBFB42, 0x19491A1F), LEPT_U64(0x1014EBE6, 0xC5F90BF8) }, /* 1e-322 */
+    { LEPT_U64(0xCA66FA12, 0x9F9B60A6), LEPT_U64(0xD41A26E0, 0x77774EF6) }, /* 1e-321 */
+    { LEPT_U64(0xFD00B897, 0x478238D0), LEPT_U64(0x8920B098, 0x955522B4) }, /* 1e-320 */
+    { LEPT_U64(0x9E20735E, 0x8CB16382), LEPT_U64(0x55B46E5F, 0x5D5535B0) }, /* 1e-319 */
+    { LEPT_U64(0xC5A89036, 0x2FDDBC62), LEPT_U64(0xEB2189F7, 0x34AA831D) }, /* 1e-318 */
+    { LEPT_U64(0xF712B443, 0xBBD52B7B), LEPT_U64(0xA5E9EC75, 0x01D523E4) }, /* 1e-317 */
+    { LEPT_U64(0x9A6BB0AA, 0x55653B2D), LEPT_U64(0x47B233C9, 0x2125366E) }, /* 1e-316 */
+    { LEPT_U64(0xC1069CD4, 0xEABE89F8), LEPT_U64(0x999EC0BB, 0x696E840A) }, /* 1e-315 */
+    { LEPT_U64(0xF148440A, 0x256E2C76), LEPT_U64(0xC00670EA, 0x43CA250D) }, /* 1e-314 */
+    { LEPT_U64(0x96CD2A86, 0x5764DBCA), LEPT_U64(0x38040692, 0x6A5E5728) }, /* 1e-313 */
+    { LEPT_U64(0xBC807527, 0xED3E12BC), LEPT_U64(0xC6050837, 0x04F5ECF2) }, /* 1e-312 */
+    { LEPT_U64(0xEBA09271, 0xE88D976B), LEPT_U64(0xF7864A44, 0xC633682E) }, /* 1e-311 */
+    { LEPT_U64(0x93445B87, 0x31587EA3), LEPT_U64(0x7AB3EE6A, 0xFBE0211D) }, /* 1e-310 */
+    { LEPT_U64(0xB8157268, 0xFDAE9E4C), LEPT_U64(0x5960EA05, 0xBAD82964) }, /* 1e-309 */
+    { LEPT_U64(0xE61ACF03, 0x3D1A45DF), LEPT_U64(0x6FB92487, 0x298E33BD) }, /* 1e-308 */
+    { LEPT_U64(0x8FD0C162, 0x06306BAB), LEPT_U64(0xA5D3B6D4, 0x79F8E056) }, /* 1e-307 */
+    { LEPT_U64(0xB3C4F1BA, 0x87BC8696), LEPT_U64(0x8F48A489, 0x9877186C) }, /* 1e-306 */
+    { LEPT_U64(0xE0B62E29, 0x29ABA83C), LEPT_U64(0x331ACDAB, 0xFE94DE87) }, /* 1e-305 */
+    { LEPT_U64(0x8C71DCD9, 0xBA0B4925), LEPT_U64(0x9FF0C08B, 0x7F1D0B14) }, /* 1e-304 */
+    { LEPT_U64(0xAF8E5410, 0x288E1B6F), LEPT_U64(0x07ECF0AE, 0x5EE44DD9) }, /* 1e-303 */
+    { LEPT_U64(0xDB71E914, 0x32B1A24A), LEPT_U64(0xC9E82CD9, 0xF69D6150) }, /* 1e-302 */
+    { LEPT_U64(0x892731AC, 0x9FAF056E), LEPT_U64(0xBE311C08, 0x3A225CD2) }, /* 1e-301 */
+    { LEPT_U64(0xAB70FE17, 0xC79AC6CA), LEPT_U64(0x6DBD630A, 0x48AAF406) }, /* 1e-300 */
+    { LEPT_U64(0xD64D3D9D, 0xB981787D), LEPT_U64(0x092CBBCC, 0xDAD5B108) }, /* 1e-299 */
+    { LEPT_U64(0x85F04682, 0x93F0EB4E), LEPT_U64(0x25BBF560, 0x08C58EA5) }, /* 1e-298 */
+    { LEPT_U64(0xA76C5823, 0x38ED2621), LEPT_U64(0xAF2AF2B8, 0x0AF6F24E) }, /* 1e-297 */
+    { LEPT_U64(0xD1476E2C, 0x07286FAA), LEPT_U64(0x1AF5AF66, 0x0DB4AEE1) }, /* 1e-296 */
+    { LEPT_U64(0x82CCA4DB, 0x847945CA), LEPT_U64(0x50D98D9F, 0xC890ED4D) }, /* 1e-295 */
+    { LEPT_U64(0xA37FCE12, 0x6597973C), LEPT_U64(0xE50FF107, 0xBAB528A0) }, /* 1e-294 */
+    { LEPT_U64(0xCC5FC196, 0xFEFD7D0C), LEPT_U64(0x1E53ED49, 0xA96272C8) }, /* 1e-293 */
+    { LEPT_U64(0xFF77B1FC, 0xBEBCDC4F), LEPT_U64(0x25E8E89C, 0x13BB0F7A) }, /* 1e-292 */
+    { LEPT_U64(0x9FAACF3D, 0xF73609B1), LEPT_U64(0x77B19161, 0x8C54E9AC) }, /* 1e-291 */
+    { LEPT_U64(0xC795830D, 0x75038C1D), LEPT_U64(0xD59DF5B9, 0xEF6A2417) }, /* 1e-290 */
+    { LEPT_U64(0xF97AE3D0, 0xD2446F25), LEPT_U64(0x4B057328, 0x6B44AD1D) }, /* 1e-289 */
+    { LEPT_U64(0x9BECCE62, 0x836AC577), LEPT_U64(0x4EE367F9, 0x430AEC32) }, /* 1e-288 */
+    { LEPT_U64(0xC2E801FB, 0x244576D5), LEPT_U64(0x229C41F7, 0x93CDA73F) }, /* 1e-287 */
+    { LEPT_U64(0xF3A20279, 0xED56D48A), LEPT_U64(0x6B435275, 0x78C1110F) }, /* 1e-286 */
+    { LEPT_U64(0x9845418C, 0x345644D6), LEPT_U64(0x830A1389, 0x6B78AAA9) }, /* 1e-285 */
+    { LEPT_U64(0xBE5691EF, 0x416BD60C), LEPT_U64(0x23CC986B, 0xC656D553) }, /* 1e-284 */
+    { LEPT_U64(0xEDEC366B, 0x11C6CB8F), LEPT_U64(0x2CBFBE86, 0xB7EC8AA8) }, /* 1e-283 */
+    { LEPT_U64(0x94B3A202, 0xEB1C3F39), LEPT_U64(0x7BF7D714, 0x32F3D6A9) }, /* 1e-282 */
+    { LEPT_U64(0xB9E08A83, 0xA5E34F07), LEPT_U64(0xDAF5CCD9, 0x3FB0CC53) }, /* 1e-281 */
+    { LEPT_U64(0xE858AD24, 0x8F5C22C9), LEPT_U64(0xD1B3400F, 0x8F9CFF68) }, /* 1e-280 */
+    { LEPT_U64(0x91376C36, 0xD99995BE), LEPT_U64(0x23100809, 0xB9C21FA1) }, /* 1e-279 */
+    { LEPT_U64(0xB5854744, 0x8FFFFB2D), LEPT_U64(0xABD40A0C, 0x2832A78A) }, /* 1e-278 */
+    { LEPT_U64(0xE2E69915, 0xB3FFF9F9), LEPT_U64(0x16C90C8F, 0x323F516C) }, /* 1e-277 */
+    { LEPT_U64(0x8DD01FAD, 0x907FFC3B), LEPT_U64(0xAE3DA7D9, 0x7F6792E3) }, /* 1e-276 */
+    { LEPT_U64(0xB1442798, 0xF49FFB4A), LEPT_U64(0x99CD11CF, 0xDF41779C) }, /* 1e-275 */
+    { LEPT_U64(0xDD95317F, 0x31C7FA1D), LEPT_U64(0x40405643, 0xD711D583) }, /* 1e-274 */
+    { LEPT_U64(0x8A7D3EEF, 0x7F1CFC52), LEPT_U64(0x482835EA, 0x666B2572) }, /* 1e-273 */
+    { LEPT_U64(0xAD1C8EAB, 0x5EE43B66), LEPT_U64(0xDA324365, 0x0005EECF) }, /* 1e-272 */
+    { LEPT_U64(0xD863B256, 0x369D4A40), LEPT_U64(0x90BED43E, 0x40076A82) }, /* 1e-271 */
+    { LEPT_U64(0x873E4F75, 0xE2224E68), LEPT_U64(0x5A7744A6, 0xE804A291) }, /* 1e-270 */
+    { LEPT_U64(0xA90DE353, 0x5AAAE202), LEPT_U64(0x711515D0, 0xA205CB36) }, /* 1e-269 */
+    { LEPT_U64(0xD3515C28, 0x31559A83), LEPT_U64(0x0D5A5B44, 0xCA873E03) }, /* 1e-268 */
+    { LEPT_U64(0x8412D999, 0x1ED58091), LEPT_U64(0xE858790A, 0xFE9486C2) }, /* 1e-267 */
+    { LEPT_U64(0xA5178FFF, 0x668AE0B6), LEPT_U64(0x626E974D, 0xBE39A872) }, /* 1e-266 */
+    { LEPT_U64(0xCE5D73FF, 0x402D98E3), LEPT_U64(0xFB0A3D21, 0x2DC8128F) }, /* 1e-265 */
+    { LEPT_U64(0x80FA687F, 0x881C7F8E), LEPT_U64(0x7CE66634, 0xBC9D0B99) }, /* 1e-264 */
+    { LEPT_U64(0xA139029F, 0x6A239F72), LEPT_U64(0x1C1FFFC1, 0xEBC44E80) }, /* 1e-263 */
+    { LEPT_U64(0xC9874347, 0x44AC874E), LEPT_U64(0xA327FFB2, 0x66B56220) }, /* 1e-262 */
+    { LEPT_U64(0xFBE91419, 0x15D7A922), LEPT_U64(0x4BF1FF9F, 0x0062BAA8) }, /* 1e-261 */
+    { LEPT_U64(0x9D71AC8F, 0xADA6C9B5), LEPT_U64(0x6F773FC3, 0x603DB4A9) }, /* 1e-260 */
+    { LEPT_U64(0xC4CE17B3, 0x99107C22), LEPT_U64(0xCB550FB4, 0x384D21D3) }, /* 1e-259 */
+    { LEPT_U64(0xF6019DA0, 0x7F549B2B), LEPT_U64(0x7E2A53A1, 0x46606A48) }, /* 1e-258 */
+    { LEPT_U64(0x99C10284, 0x4F94E0FB), LEPT_U64(0x2EDA7444, 0xCBFC426D) }, /* 1e-257 */
+    { LEPT_U64(0xC0314325, 0x637A1939), LEPT_U64(0xFA911155, 0xFEFB5308) }, /* 1e-256 */
+    { LEPT_U64(0xF03D93EE, 0xBC589F88), LEPT_U64(0x793555AB, 0x7EBA27CA) }, /* 1e-255 */
+    { LEPT_U64(0x96267C75, 0x35B763B5), LEPT_U64(0x4BC1558B, 0x2F3458DE) }, /* 1e-254 */
+    { LEPT_U64(0xBBB01B92, 0x83253CA2), LEPT_U64(0x9EB1AAED, 0xFB016F16) }, /* 1e-253 */
+    { LEPT_U64(0xEA9C2277, 0x23EE8BCB), LEPT_U64(0x465E15A9, 0x79C1CADC) }, /* 1e-252 */
+    { LEPT_U64(0x92A1958A, 0x7675175F), LEPT_U64(0x0BFACD89, 0xEC191EC9) }, /* 1e-251 */
+    { LEPT_U64(0xB749FAED, 0x14125D36), LEPT_U64(0xCEF980EC, 0x671F667B) }, /* 1e-250 */
+    { LEPT_U64(0xE51C79A8, 0x5916F484), LEPT_U64(0x82B7E127, 0x80E7401A) }, /* 1e-249 */
+    { LEPT_U64(0x8F31CC09, 0x37AE58D2), LEPT_U64(0xD1B2ECB8, 0xB0908810) }, /* 1e-248 */
+    { LEPT_U64(0xB2FE3F0B, 0x8599EF07), LEPT_U64(0x861FA7E6, 0xDCB4AA15) }, /* 1e-247 */
+    { LEPT_U64(0xDFBDCECE, 0x67006AC9), LEPT_U64(0x67A791E0, 0x93E1D49A) }, /* 1e-246 */
+    { LEPT_U64(0x8BD6A141, 0x006042BD), LEPT_U64(0xE0C8BB2C, 0x5C6D24E0) }, /* 1e-245 */
+    { LEPT_U64(0xAECC4991, 0x4078536D), LEPT_U64(0x58FAE9F7, 0x73886E18) }, /* 1e-244 */
+    { LEPT_U64(0xDA7F5BF5, 0x90966848), LEPT_U64(0xAF39A475, 0x506A899E) }, /* 1e-243 */
+    { LEPT_U64(0x888F9979, 0x7A5E012D), LEPT_U64(0x6D8406C9, 0x52429603) }, /* 1e-242 */
+    { LEPT_U64(0xAAB37FD7, 0xD8F58178), LEPT_U64(0xC8E5087B, 0xA6D33B83) }, /* 1e-241 */
+    { LEPT_U64(0xD5605FCD, 0xCF32E1D6), LEPT_U64(0xFB1E4A9A, 0x90880A64) }, /* 1e-240 */
+    { LEPT_U64(0x855C3BE0, 0xA17FCD26), LEPT_U64(0x5CF2EEA0, 0x9A55067F) }, /* 1e-239 */
+    { LEPT_U64(0xA6B34AD8, 0xC9DFC06F), LEPT_U64(0xF42FAA48, 0xC0EA481E) }, /* 1e-238 */
+    { LEPT_U64(0xD0601D8E, 0xFC57B08B), LEPT_U64(0xF13B94DA, 0xF124DA26) }, /* 1e-237 */
+    { LEPT_U64(0x823C1279, 0x5DB6CE57), LEPT_U64(0x76C53D08, 0xD6B70858) }, /* 1e-236 */
+    { LEPT_U64(0xA2CB1717, 0xB52481ED), LEPT_U64(0x54768C4B, 0x0C64CA6E) }, /* 1e-235 */
+    { LEPT_U64(0xCB7DDCDD, 0xA26DA268), LEPT_U64(0xA9942F5D, 0xCF7DFD09) }, /* 1e-234 */
+    { LEPT_U64(0xFE5D5415, 0x0B090B02), LEPT_U64(0xD3F93B35, 0x435D7C4C) }, /* 1e-233 */
+    { LEPT_U64(0x9EFA548D, 0x26E5A6E1), LEPT_U64(0xC47BC501, 0x4A1A6DAF) }, /* 1e-232 */
+    { LEPT_U64(0xC6B8E9B0, 0x709F109A), LEPT_U64(0x359AB641, 0x9CA1091B) }, /* 1e-231 */
+    { LEPT_U64(0xF867241C, 0x8CC6D4C0), LEPT_U64(0xC30163D2, 0x03C94B62) }, /* 1e-230 */
+    { LEPT_U64(0x9B407691, 0xD7FC44F8), LEPT_U64(0x79E0DE63, 0x425DCF1D) }, /* 1e-229 */
+    { LEPT_U64(0xC2109436, 0x4DFB5636), LEPT_U64(0x985915FC, 0x12F542E4) }, /* 1e-228 */
+    { LEPT_U64(0xF294B943, 0xE17A2BC4), LEPT_U64(0x3E6F5B7B, 0x17B2939D) }, /* 1e-227 */
+    { LEPT_U64(0x979CF3CA, 0x6CEC5B5A), LEPT_U64(0xA705992C, 0xEECF9C42) }, /* 1e-226 */
+    { LEPT_U64(0xBD8430BD, 0x08277231), LEPT_U64(0x50C6FF78, 0x2A838353) }, /* 1e-225 */
+    { LEPT_U64(0xECE53CEC, 0x4A314EBD), LEPT_U64(0xA4F8BF56, 0x35246428) }, /* 1e-224 */
+    { LEPT_U64(0x940F4613, 0xAE5ED136), LEPT_U64(0x871B7795, 0xE136BE99) }, /* 1e-223 */
+    { LEPT_U64(0xB9131798, 0x99F68584), LEPT_U64(0x28E2557B, 0x59846E3F) }, /* 1e-222 */
+    { LEPT_U64(0xE757DD7E, 0xC07426E5), LEPT_U64(0x331AEADA, 0x2FE589CF) }, /* 1e-221 */
+    { LEPT_U64(0x9096EA6F, 0x3848984F), LEPT_U64(0x3FF0D2C8, 0x5DEF7621) }, /* 1e-220 */
+    { LEPT_U64(0xB4BCA50B, 0x065ABE63), LEPT_U64(0x0FED077A, 0x756B53A9) }, /* 1e-219 */
+    { LEPT_U64(0xE1EBCE4D, 0xC7F16DFB), LEPT_U64(0xD3E84959, 0x12C62894) }, /* 1e-218 */
+    { LEPT_U64(0x8D3360F0, 0x9CF6E4BD), LEPT_U64(0x64712DD7, 0xABBBD95C) }, /* 1e-217 */
+    { LEPT_U64(0xB080392C, 0xC4349DEC), LEPT_U64(0xBD8D794D, 0x96AACFB3) }, /* 1e-216 */
+    { LEPT_U64(0xDCA04777, 0xF541C567), LEPT_U64(0xECF0D7A0, 0xFC5583A0) }, /* 1e-215 */
+    { LEPT_U64(0x89E42CAA, 0xF9491B60), LEPT_U64(0xF41686C4, 0x9DB57244) }, /* 1e-214 */
+    { LEPT_U64(0xAC5D37D5, 0xB79B6239), LEPT_U64(0x311C2875, 0xC522CED5) }, /* 1e-213 */
+    { LEPT_U64(0xD77485CB, 0x25823AC7), LEPT_U64(0x7D633293, 0x366B828B) }, /* 1e-212 */
+    { LEPT_U64(0x86A8D39E, 0xF77164BC), LEPT_U64(0xAE5DFF9C, 0x02033197) }, /* 1e-211 */
+    { LEPT_U64(0xA8530886, 0xB54DBDEB), LEPT_U64(0xD9F57F83, 0x0283FDFC) }, /* 1e-210 */
+    { LEPT_U64(0xD267CAA8, 0x62A12D66), LEPT_U64(0xD072DF63, 0xC324FD7B) }, /* 1e-209 */
+    { LEPT_U64(0x8380DEA9, 0x3DA4BC60), LEPT_U64(0x4247CB9E, 0x59F71E6D) }, /* 1e-208 */
+    { LEPT_U64(0xA4611653, 0x8D0DEB78), LEPT_U64(0x52D9BE85, 0xF074E608) }, /* 1e-207 */
+    { LEPT_U64(0xCD795BE8, 0x70516656), LEPT_U64(0x67902E27, 0x6C921F8B) }, /* 1e-206 */
+    { LEPT_U64(0x806BD971, 0x4632DFF6), LEPT_U64(0x00BA1CD8, 0xA3DB53B6) }, /* 1e-205 */
+    { LEPT_U64(0xA086CFCD, 0x97BF97F3), LEPT_U64(0x80E8A40E, 0xCCD228A4) }, /* 1e-204 */
+    { LEPT_U64(0xC8A883C0, 0xFDAF7DF0), LEPT_U64(0x6122CD12, 0x8006B2CD) }, /* 1e-203 */
+    { LEPT_U64(0xFAD2A4B1, 0x3D1B5D6C), LEPT_U64(0x796B8057, 0x20085F81) }, /* 1e-202 */
+    { LEPT_U64(0x9CC3A6EE, 0xC6311A63), LEPT_U64(0xCBE33036, 0x74053BB0) }, /* 1e-201 */
+    { LEPT_U64(0xC3F490AA, 0x77BD60FC), LEPT_U64(0xBEDBFC44, 0x11068A9C) }, /* 1e-200 */
+    { LEPT_U64(0xF4F1B4D5, 0x15ACB93B), LEPT_U64(0xEE92FB55, 0x15482D44) }, /* 1e-199 */
+    { LEPT_U64(0x99171105, 0x2D8BF3C5), LEPT_U64(0x751BDD15, 0x2D4D1C4A) }, /* 1e-198 */
+    { LEPT_U64(0xBF5CD546, 0x78EEF0B6), LEPT_U64(0xD262D45A, 0x78A0635D) }, /* 1e-197 */
+    { LEPT_U64(0xEF340A98, 0x172AACE4), LEPT_U64(0x86FB8971, 0x16C87C34) }, /* 1e-196 */
+    { LEPT_U64(0x9580869F, 0x0E7AAC0E), LEPT_U64(0xD45D35E6, 0xAE3D4DA0) }, /* 1e-195 */
+    { LEPT_U64(0xBAE0A846, 0xD2195712), LEPT_U64(0x89748360, 0x59CCA109) }, /* 1e-194 */
+    { LEPT_U64(0xE998D258, 0x869FACD7), LEPT_U64(0x2BD1A438, 0x703FC94B) }, /* 1e-193 */
+    { LEPT_U64(0x91FF8377, 0x5423CC06), LEPT_U64(0x7B6306A3, 0x4627DDCF) }, /* 1e-192 */
+    { LEPT_U64(0xB67F6455, 0x292CBF08), LEPT_U64(0x1A3BC84C, 0x17B1D542) }, /* 1e-191 */
+    { LEPT_U64(0xE41F3D6A, 0x7377EECA), LEPT_U64(0x20CABA5F, 0x1D9E4A93) }, /* 1e-190 */
+    { LEPT_U64(0x8E938662, 0x882AF53E), LEPT_U64(0x547EB47B, 0x7282EE9C) }, /* 1e-189 */
+    { LEPT_U64(0xB23867FB, 0x2A35B28D), LEPT_U64(0xE99E619A, 0x4F23AA43) }, /* 1e-188 */
+    { LEPT_U64(0xDEC681F9, 0xF4C31F31), LEPT_U64(0x6405FA00, 0xE2EC94D4) }, /* 1e-187 */
+    { LEPT_U64(0x8B3C113C, 0x38F9F37E), LEPT_U64(0xDE83BC40, 0x8DD3DD04) }, /* 1e-186 */
+    { LEPT_U64(0xAE0B158B, 0x4738705E), LEPT_U64(0x9624AB50, 0xB148D445) }, /* 1e-185 */
+    { LEPT_U64(0xD98DDAEE, 0x19068C76), LEPT_U64(0x3BADD624, 0xDD9B0957) }, /* 1e-184 */
+    { LEPT_U64(0x87F8A8D4, 0xCFA417C9), LEPT_U64(0xE54CA5D7, 0x0A80E5D6) }, /* 1e-183 */
+    { LEPT_U64(0xA9F6D30A, 0x038D1DBC), LEPT_U64(0x5E9FCF4C, 0xCD211F4C) }, /* 1e-182 */
+    { LEPT_U64(0xD47487CC, 0x8470652B), LEPT_U64(0x7647C320, 0x0069671F) }, /* 1e-181 */
+    { LEPT_U64(0x84C8D4DF, 0xD2C63F3B), LEPT_U64(0x29ECD9F4, 0x0041E073) }, /* 1e-180 */
+    { LEPT_U64(0xA5FB0A17, 0xC777CF09), LEPT_U64(0xF4681071, 0x00525890) }, /* 1e-179 */
+    { LEPT_U64(0xCF79CC9D, 0xB955C2CC), LEPT_U64(0x7182148D, 0x4066EEB4) }, /* 1e-178 */
+    { LEPT_U64(0x81AC1FE2, 0x93D599BF), LEPT_U64(0xC6F14CD8, 0x48405530) }, /* 1e-177 */
+    { LEPT_U64(0xA21727DB, 0x38CB002F), LEPT_U64(0xB8ADA00E, 0x5A506A7C) }, /* 1e-176 */
+    { LEPT_U64(0xCA9CF1D2, 0x06FDC03B), LEPT_U64(0xA6D90811, 0xF0E4851C) }, /* 1e-175 */
+    { LEPT_U64(0xFD442E46, 0x88BD304A), LEPT_U64(0x908F4A16, 0x6D1DA663) }, /* 1e-174 */
+    { LEPT_U64(0x9E4A9CEC, 0x15763E2E), LEPT_U64(0x9A598E4E, 0x043287FE) }, /* 1e-173 */
+    { LEPT_U64(0xC5DD4427, 0x1AD3CDBA), LEPT_U64(0x40EFF1E1, 0x853F29FD) }, /* 1e-172 */
+    { LEPT_U64(0xF7549530, 0xE188C128), LEPT_U64(0xD12BEE59, 0xE68EF47C) }, /* 1e-171 */
+    { LEPT_U64(0x9A94DD3E, 0x8CF578B9), LEPT_U64(0x82BB74F8, 0x301958CE) }, /* 1e-170 */
+    { LEPT_U64(0xC13A148E, 0x3032D6E7), LEPT_U64(0xE36A5236, 0x3C1FAF01) }, /* 1e-169 */
+    { LEPT_U64(0xF18899B1, 0xBC3F8CA1), LEPT_U64(0xDC44E6C3, 0xCB279AC1) }, /* 1e-168 */
+    { LEPT_U64(0x96F5600F, 0x15A7B7E5), LEPT_U64(0x29AB103A, 0x5EF8C0B9) }, /* 1e-167 */
+    { LEPT_U64(0xBCB2B812, 0xDB11A5DE), LEPT_U64(0x7415D448, 0xF6B6F0E7) }, /* 1e-166 */
+    { LEPT_U64(0xEBDF6617, 0x91D60F56), LEPT_U64(0x111B495B, 0x3464AD21) }, /* 1e-165 */
+    { LEPT_U64(0x936B9FCE, 0xBB25C995), LEPT_U64(0xCAB10DD9, 0x00BEEC34) }, /* 1e-164 */
+    { LEPT_U64(0xB84687C2, 0x69EF3BFB), LEPT_U64(0x3D5D514F, 0x40EEA742) }, /* 1e-163 */
+    { LEPT_U64(0xE65829B3, 0x046B0AFA), LEPT_U64(0x0CB4A5A3, 0x112A5112) }, /* 1e-162 */
+    { LEPT_U64(0x8FF71A0F, 0xE2C2E6DC), LEPT_U64(0x47F0E785, 0xEABA72AB) }, /* 1e-161 */
+    { LEPT_U64(0xB3F4E093, 0xDB73A093), LEPT_U64(0x59ED2167, 0x65690F56) }, /* 1e-160 */
+    { LEPT_U64(0xE0F218B8, 0xD25088B8), LEPT_U64(0x306869C1, 0x3EC3532C) }, /* 1e-159 */
+    { LEPT_U64(0x8C974F73, 0x83725573), LEPT_U64(0x1E414218, 0xC73A13FB) }, /* 1e-158 */
+    { LEPT_U64(0xAFBD2350, 0x644EEACF), LEPT_U64(0xE5D1929E, 0xF90898FA) }, /* 1e-157 */
+    { LEPT_U64(0xDBAC6C24, 0x7D62A583), LEPT_U64(0xDF45F746, 0xB74ABF39) }, /* 1e-156 */
+    { LEPT_U64(0x894BC396, 0xCE5DA772), LEPT_U64(0x6B8BBA8C, 0x328EB783) }, /* 1e-155 */
+    { LEPT_U64(0xAB9EB47C, 0x81F5114F), LEPT_U64(0x066EA92F, 0x3F326564) }, /* 1e-154 */
+    { LEPT_U64(0xD686619B, 0xA27255A2), LEPT_U64(0xC80A537B, 0x0EFEFEBD) }, /* 1e-153 */
+    { LEPT_U64(0x8613FD01, 0x45877585), LEPT_U64(0xBD06742C, 0xE95F5F36) }, /* 1e-152 */
+    { LEPT_U64(0xA798FC41, 0x96E952E7), LEPT_U64(0x2C481138, 0x23B73704) }, /* 1e-151 */
+    { LEPT_U64(0xD17F3B51, 0xFCA3A7A0), LEPT_U64(0xF75A1586, 0x2CA504C5) }, /* 1e-150 */
+    { LEPT_U64(0x82EF8513, 0x3DE648C4), LEPT_U64(0x9A984D73, 0xDBE722FB) }, /* 1e-149 */
+    { LEPT_U64(0xA3AB6658, 0x0D5FDAF5), LEPT_U64(0xC13E60D0, 0xD2E0EBBA) }, /* 1e-148 */
+    { LEPT_U64(0xCC963FEE, 0x10B7D1B3), LEPT_U64(0x318DF905, 0x079926A8) }, /* 1e-147 */
+    { LEPT_U64(0xFFBBCFE9, 0x94E5C61F), LEPT_U64(0xFDF17746, 0x497F7052) }, /* 1e-146 */
+    { LEPT_U64(0x9FD561F1, 0xFD0F9BD3), LEPT_U64(0xFEB6EA8B, 0xEDEFA633) }, /* 1e-145 */
+    { LEPT_U64(0xC7CABA6E, 0x7C5382C8), LEPT_U64(0xFE64A52E, 0xE96B8FC0) }, /* 1e-144 */
+    { LEPT_U64(0xF9BD690A, 0x1B68637B), LEPT_U64(0x3DFDCE7A, 0xA3C673B0) }, /* 1e-143 */
+    { LEPT_U64(0x9C1661A6, 0x51213E2D), LEPT_U64(0x06BEA10C, 0xA65C084E) }, /* 1e-142 */
+    { LEPT_U64(0xC31BFA0F, 0xE5698DB8), LEPT_U64(0x486E494F, 0xCFF30A62) }, /* 1e-141 */
+    { LEPT_U64(0xF3E2F893, 0xDEC3F126), LEPT_U64(0x5A89DBA3, 0xC3EFCCFA) }, /* 1e-140 */
+    { LEPT_U64(0x986DDB5C, 0x6B3A76B7), LEPT_U64(0xF8962946, 0x5A75E01C) }, /* 1e-139 */
+    { LEPT_U64(0xBE895233, 0x86091465), LEPT_U64(0xF6BBB397, 0xF1135823) }, /* 1e-138 */
+    { LEPT_U64(0xEE2BA6C0, 0x678B597F), LEPT_U64(0x746AA07D, 0xED582E2C) }, /* 1e-137 */
+    { LEPT_U64(0x94DB4838, 0x40B717EF), LEPT_U64(0xA8C2A44E, 0xB4571CDC) }, /* 1e-136 */
+    { LEPT_U64(0xBA121A46, 0x50E4DDEB), LEPT_U64(0x92F34D62, 0x616CE413) }, /* 1e-135 */
+    { LEPT_U64(0xE896A0D7, 0xE51E1566), LEPT_U64(0x77B020BA, 0xF9C81D17) }, /* 1e-134 */
+    { LEPT_U64(0x915E2486, 0xEF32CD60), LEPT_U64(0x0ACE1474, 0xDC1D122E) }, /* 1e-133 */
+    { LEPT_U64(0xB5B5ADA8, 0xAAFF80B8), LEPT_U64(0x0D819992, 0x132456BA) }, /* 1e-132 */
+    { LEPT_U64(0xE3231912, 0xD5BF60E6), LEPT_U64(0x10E1FFF6, 0x97ED6C69) }, /* 1e-131 */
+    { LEPT_U64(0x8DF5EFAB, 0xC5979C8F), LEPT_U64(0xCA8D3FFA, 0x1EF463C1) }, /* 1e-130 */
+    { LEPT_U64(0xB1736B96, 0xB6FD83B3), LEPT_U64(0xBD308FF8, 0xA6B17CB2) }, /* 1e-129 */
+    { LEPT_U64(0xDDD0467C, 0x64BCE4A0), LEPT_U64(0xAC7CB3F6, 0xD05DDBDE) }, /* 1e-128 */
+    { LEPT_U64(0x8AA22C0D, 0xBEF60EE4), LEPT_U64(0x6BCDF07A, 0x423AA96B) }, /* 1e-127 */
+    { LEPT_U64(0xAD4AB711, 0x2EB3929D), LEPT_U64(0x86C16C98, 0xD2C953C6) }, /* 1e-126 */
+    { LEPT_U64(0xD89D64D5, 0x7A607744), LEPT_U64(0xE871C7BF, 0x077BA8B7) }, /* 1e-125 */
+    { LEPT_U64(0x87625F05, 0x6C7C4A8B), LEPT_U64(0x11471CD7, 0x64AD4972) }, /* 1e-124 */
+    { LEPT_U64(0xA93AF6C6, 0xC79B5D2D), LEPT_U64(0xD598E40D, 0x3DD89BCF) }, /* 1e-123 */
+    { LEPT_U64(0xD389B478, 0x79823479), LEPT_U64(0x4AFF1D10, 0x8D4EC2C3) }, /* 1e-122 */
+    { LEPT_U64(0x843610CB, 0x4BF160CB), LEPT_U64(0xCEDF722A, 0x585139BA) }, /* 1e-121 */
+    { LEPT_U64(0xA54394FE, 0x1EEDB8FE), LEPT_U64(0xC2974EB4, 0xEE658828) }, /* 1e-120 */
+    { LEPT_U64(0xCE947A3D, 0xA6A9273E), LEPT_U64(0x733D2262, 0x29FEEA32) }, /* 1e-119 */
+    { LEPT_U64(0x811CCC66, 0x8829B887), LEPT_U64(0x0806357D, 0x5A3F525F) }, /* 1e-118 */
+    { LEPT_U64(0xA163FF80, 0x2A3426A8), LEPT_U64(0xCA07C2DC, 0xB0CF26F7) }, /* 1e-117 */
+    { LEPT_U64(0xC9BCFF60, 0x34C13052), LEPT_U64(0xFC89B393, 0xDD02F0B5) }, /* 1e-116 */
+    { LEPT_U64(0xFC2C3F38, 0x41F17C67), LEPT_U64(0xBBAC2078, 0xD443ACE2) }, /* 1e-115 */
+    { LEPT_U64(0x9D9BA783, 0x2936EDC0), LEPT_U64(0xD54B944B, 0x84AA4C0D) }, /* 1e-114 */
+    { LEPT_U64(0xC5029163, 0xF384A931), LEPT_U64(0x0A9E795E, 0x65D4DF11) }, /* 1e-113 */
+    { LEPT_U64(0xF64335BC, 0xF065D37D), LEPT_U64(0x4D4617B5, 0xFF4A16D5) }, /* 1e-112 */
+    { LEPT_U64(0x99EA0196, 0x163FA42E), LEPT_U64(0x504BCED1, 0xBF8E4E45) }, /* 1e-111 */
+    { LEPT_U64(0xC06481FB, 0x9BCF8D39), LEPT_U64(0xE45EC286, 0x2F71E1D6) }, /* 1e-110 */
+    { LEPT_U64(0xF07DA27A, 0x82C37088), LEPT_U64(0x5D767327, 0xBB4E5A4C) }, /* 1e-109 */
+    { LEPT_U64(0x964E858C, 0x91BA2655), LEPT_U64(0x3A6A07F8, 0xD510F86F) }, /* 1e-108 */
+    { LEPT_U64(0xBBE226EF, 0xB628AFEA), LEPT_U64(0x890489F7, 0x0A55368B) }, /* 1e-107 */
+    { LEPT_U64(0xEADAB0AB, 0xA3B2DBE5), LEPT_U64(0x2B45AC74, 0xCCEA842E) }, /* 1e-106 */
+    { LEPT_U64(0x92C8AE6B, 0x464FC96F), LEPT_U64(0x3B0B8BC9, 0x0012929D) }, /* 1e-105 */
+    { LEPT_U64(0xB77ADA06, 0x17E3BBCB), LEPT_U64(0x09CE6EBB, 0x40173744) }, /* 1e-104 */
+    { LEPT_U64(0xE5599087, 0x9DDCAABD), LEPT_U64(0xCC420A6A, 0x101D0515) }, /* 1e-103 */
+    { LEPT_U64(0x8F57FA54, 0xC2A9EAB6), LEPT_U64(0x9FA94682, 0x4A12232D) }, /* 1e-102 */
+    { LEPT_U64(0xB32DF8E9, 0xF3546564), LEPT_U64(0x47939822, 0xDC96ABF9) }, /* 1e-101 */
+    { LEPT_U64(0xDFF97724, 0x70297EBD), LEPT_U64(0x59787E2B, 0x93BC56F7) }, /* 1e-100 */
+    { LEPT_U64(0x8BFBEA76, 0xC619EF36), LEPT_U64(0x57EB4EDB, 0x3C55B65A) }, /* 1e-99 */
+    { LEPT_U64(0xAEFAE514, 0x77A06B03), LEPT_U64(0xEDE62292, 0x0B6B23F1) }, /* 1e-98 */
+    { LEPT_U64(0xDAB99E59, 0x958885C4), LEPT_U64(0xE95FAB36, 0x8E45ECED) }, /* 1e-97 */
+    { LEPT_U64(0x88B402F7, 0xFD75539B), LEPT_U64(0x11DBCB02, 0x18EBB414) }, /* 1e-96 */
+    { LEPT_U64(0xAAE103B5, 0xFCD2A881), LEPT_U64(0xD652BDC2, 0x9F26A119) }, /* 1e-95 */
+    { LEPT_U64(0xD59944A3, 0x7C0752A2), LEPT_U64(0x4BE76D33, 0x46F0495F) }, /* 1e-94 */
+    { LEPT_U64(0x857FCAE6, 0x2D8493A5), LEPT_U64(0x6F70A440, 0x0C562DDB) }, /* 1e-93 */
+    { LEPT_U64(0xA6DFBD9F, 0xB8E5B88E), LEPT_U64(0xCB4CCD50, 0x0F6BB952) }, /* 1e-92 */
+    { LEPT_U64(0xD097AD07, 0xA71F26B2), LEPT_U64(0x7E2000A4, 0x1346A7A7) }, /* 1e-91 */
+    { LEPT_U64(0x825ECC24, 0xC873782F), LEPT_U64(0x8ED40066, 0x8C0C28C8) }, /* 1e-90 */
+    { LEPT_U64(0xA2F67F2D, 0xFA90563B), LEPT_U64(0x72890080, 0x2F0F32FA) }, /* 1e-89 */
+    { LEPT_U64(0xCBB41EF9, 0x79346BCA), LEPT_U64(0x4F2B40A0, 0x3AD2FFB9) }, /* 1e-88 */
+    { LEPT_U64(0xFEA126B7, 0xD78186BC), LEPT_U64(0xE2F610C8, 0x4987BFA8) }, /* 1e-87 */
+    { LEPT_U64(0x9F24B832, 0xE6B0F436), LEPT_U64(0x0DD9CA7D, 0x2DF4D7C9) }, /* 1e-86 */
+    { LEPT_U64(0xC6EDE63F, 0xA05D3143), LEPT_U64(0x91503D1C, 0x79720DBB) }, /* 1e-85 */
+    { LEPT_U64(0xF8A95FCF, 0x88747D94), LEPT_U64(0x75A44C63, 0x97CE912A) }, /* 1e-84 */
+    { LEPT_U64(0x9B69DBE1, 0xB548CE7C), LEPT_U64(0xC986AFBE, 0x3EE11ABA) }, /* 1e-83 */
+    { LEPT_U64(0xC24452DA, 0x229B021B), LEPT_U64(0xFBE85BAD, 0xCE996168) }, /* 1e-82 */
+    { LEPT_U64(0xF2D56790, 0xAB41C2A2), LEPT_U64(0xFAE27299, 0x423FB9C3) }, /* 1e-81 */
+    { LEPT_U64(0x97C560BA, 0x6B0919A5), LEPT_U64(0xDCCD879F, 0xC967D41A) }, /* 1e-80 */
+    { LEPT_U64(0xBDB6B8E9, 0x05CB600F), LEPT_U64(0x5400E987, 0xBBC1C920) }, /* 1e-79 */
+    { LEPT_U64(0xED246723, 0x473E3813), LEPT_U64(0x290123E9, 0xAAB23B68) }, /* 1e-78 */
+    { LEPT_U64(0x9436C076, 0x0C86E30B), LEPT_U64(0xF9A0B672, 0x0AAF6521) }, /* 1e-77 */
+    { LEPT_U64(0xB9447093, 0x8FA89BCE), LEPT_U64(0xF808E40E, 0x8D5B3E69) }, /* 1e-76 */
+    { LEPT_U64(0xE7958CB8, 0x7392C2C2), LEPT_U64(0xB60B1D12, 0x30B20E04) }, /* 1e-75 */
+    { LEPT_U64(0x90BD77F3, 0x483BB9B9), LEPT_U64(0xB1C6F22B, 0x5E6F48C2) }, /* 1e-74 */
+    { LEPT_U64(0xB4ECD5F0, 0x1A4AA828), LEPT_U64(0x1E38AEB6, 0x360B1AF3) }, /* 1e-73 */
+    { LEPT_U64(0xE2280B6C, 0x20DD5232), LEPT_U64(0x25C6DA63, 0xC38DE1B0) }, /* 1e-72 */
+    { LEPT_U64(0x8D590723, 0x948A535F), LEPT_U64(0x579C487E, 0x5A38AD0E) }, /* 1e-71 */
+    { LEPT_U64(0xB0AF48EC, 0x79ACE837), LEPT_U64(0x2D835A9D, 0xF0C6D851) }, /* 1e-70 */
+    { LEPT_U64(0xDCDB1B27, 0x98182244), LEPT_U64(0xF8E43145, 0x6CF88E65) }, /* 1e-69 */
+    { LEPT_U64(0x8A08F0F8, 0xBF0F156B), LEPT_U64(0x1B8E9ECB, 0x641B58FF) }, /* 1e-68 */
+    { LEPT_U64(0xAC8B2D36, 0xEED2DAC5), LEPT_U64(0xE272467E, 0x3D222F3F) }, /* 1e-67 */
+    { LEPT_U64(0xD7ADF884, 0xAA879177), LEPT_U64(0x5B0ED81D, 0xCC6ABB0F) }, /* 1e-66 */
+    { LEPT_U64(0x86CCBB52, 0xEA94BAEA), LEPT_U64(0x98E94712, 0x9FC2B4E9) }, /* 1e-65 */
+    { LEPT_U64(0xA87FEA27, 0xA539E9A5), LEPT_U64(0x3F2398D7, 0x47B36224) }, /* 1e-64 */
+    { LEPT_U64(0xD29FE4B1, 0x8E88640E), LEPT_U64(0x8EEC7F0D, 0x19A03AAD) }, /* 1e-63 */
+    { LEPT_U64(0x83A3EEEE, 0xF9153E89), LEPT_U64(0x1953CF68, 0x300424AC) }, /* 1e-62 */
+    { LEPT_U64(0xA48CEAAA, 0xB75A8E2B), LEPT_U64(0x5FA8C342, 0x3C052DD7) }, /* 1e-61 */
+    { LEPT_U64(0xCDB02555, 0x653131B6), LEPT_U64(0x3792F412, 0xCB06794D) }, /* 1e-60 */
+    { LEPT_U64(0x808E1755, 0x5F3EBF11), LEPT_U64(0xE2BBD88B, 0xBEE40BD0) }, /* 1e-59 */
+    { LEPT_U64(0xA0B19D2A, 0xB70E6ED6), LEPT_U64(0x5B6ACEAE, 0xAE9D0EC4) }, /* 1e-58 */
+    { LEPT_U64(0xC8DE0475, 0x64D20A8B), LEPT_U64(0xF245825A, 0x5A445275) }, /* 1e-57 */
+    { LEPT_U64(0xFB158592, 0xBE068D2E), LEPT_U64(0xEED6E2F0, 0xF0D56712) }, /* 1e-56 */
+    { LEPT_U64(0x9CED737B, 0xB6C4183D), LEPT_U64(0x55464DD6, 0x9685606B) }, /* 1e-55 */
+    { LEPT_U64(0xC428D05A, 0xA4751E4C), LEPT_U64(0xAA97E14C, 0x3C26B886) }, /* 1e-54 */
+    { LEPT_U64(0xF5330471, 0x4D9265DF), LEPT_U64(0xD53DD99F, 0x4B3066A8) }, /* 1e-53 */
+    { LEPT_U64(0x993FE2C6, 0xD07B7FAB), LEPT_U64(0xE546A803, 0x8EFE4029) }, /* 1e-52 */
+    { LEPT_U64(0xBF8FDB78, 0x849A5F96), LEPT_U64(0xDE985204, 0x72BDD033) }, /* 1e-51 */
+    { LEPT_U64(0xEF73D256, 0xA5C0F77C), LEPT_U64(0x963E6685, 0x8F6D4440) }, /* 1e-50 */
+    { LEPT_U64(0x95A86376, 0x27989AAD), LEPT_U64(0xDDE70013, 0x79A44AA8) }, /* 1e-49 */
+    { LEPT_U64(0xBB127C53, 0xB17EC159), LEPT_U64(0x5560C018, 0x580D5D52) }, /* 1e-48 */
+    { LEPT_U64(0xE9D71B68, 0x9DDE71AF), LEPT_U64(0xAAB8F01E, 0x6E10B4A6) }, /* 1e-47 */
+    { LEPT_U64(0x92267121, 0x62AB070D), LEPT_U64(0xCAB39613, 0x04CA70E8) }, /* 1e-46 */
+    { LEPT_U64(0xB6B00D69, 0xBB55C8D1), LEPT_U64(0x3D607B97, 0xC5FD0D22) }, /* 1e-45 */
+    { LEPT_U64(0xE45C10C4, 0x2A2B3B05), LEPT_U64(0x8CB89A7D, 0xB77C506A) }, /* 1e-44 */
+    { LEPT_U64(0x8EB98A7A, 0x9A5B04E3), LEPT_U64(0x77F3608E, 0x92ADB242) }, /* 1e-43 */
+    { LEPT_U64(0xB267ED19, 0x40F1C61C), LEPT_U64(0x55F038B2, 0x37591ED3) }, /* 1e-42 */
+    { LEPT_U64(0xDF01E85F, 0x912E37A3), LEPT_U64(0x6B6C46DE, 0xC52F6688) }, /* 1e-41 */
+    { LEPT_U64(0x8B61313B, 0xBABCE2C6), LEPT_U64(0x2323AC4B, 0x3B3DA015) }, /* 1e-40 */
+    { LEPT_U64(0xAE397D8A, 0xA96C1B77), LEPT_U64(0xABEC975E, 0x0A0D081A) }, /* 1e-39 */
+    { LEPT_U64(0xD9C7DCED, 0x53C72255), LEPT_U64(0x96E7BD35, 0x8C904A21) }, /* 1e-38 */
+    { LEPT_U64(0x881CEA14, 0x545C7575), LEPT_U64(0x7E50D641, 0x77DA2E54) }, /* 1e-37 */
+    { LEPT_U64(0xAA242499, 0x697392D2), LEPT_U64(0xDDE50BD1, 0xD5D0B9E9) }, /* 1e-36 */
+    { LEPT_U64(0xD4AD2DBF, 0xC3D07787), LEPT_U64(0x955E4EC6, 0x4B44E864) }, /* 1e-35 */
+    { LEPT_U64(0x84EC3C97, 0xDA624AB4), LEPT_U64(0xBD5AF13B, 0xEF0B113E) }, /* 1e-34 */
+    { LEPT_U64(0xA6274BBD, 0xD0FADD61), LEPT_U64(0xECB1AD8A, 0xEACDD58E) }, /* 1e-33 */
+    { LEPT_U64(0xCFB11EAD, 0x453994BA), LEPT_U64(0x67DE18ED, 0xA5814AF2) }, /* 1e-32 */
+    { LEPT_U64(0x81CEB32C, 0x4B43FCF4), LEPT_U64(0x80EACF94, 0x8770CED7) }, /* 1e-31 */
+    { LEPT_U64(0xA2425FF7, 0x5E14FC31), LEPT_U64(0xA1258379, 0xA94D028D) }, /* 1e-30 */
+    { LEPT_U64(0xCAD2F7F5, 0x359A3B3E), LEPT_U64(0x096EE458, 0x13A04330) }, /* 1e-29 */
+    { LEPT_U64(0xFD87B5F2, 0x8300CA0D), LEPT_U64(0x8BCA9D6E, 0x188853FC) }, /* 1e-28 */
+    { LEPT_U64(0x9E74D1B7, 0x91E07E48), LEPT_U64(0x775EA264, 0xCF55347D) }, /* 1e-27 */
+    { LEPT_U64(0xC6120625, 0x76589DDA), LEPT_U64(0x95364AFE, 0x032A819D) }, /* 1e-26 */
+    { LEPT_U64(0xF79687AE, 0xD3EEC551), LEPT_U64(0x3A83DDBD, 0x83F52204) }, /* 1e-25 */
+    { LEPT_U64(0x9ABE14CD, 0x44753B52), LEPT_U64(0xC4926A96, 0x72793542) }, /* 1e-24 */
+    { LEPT_U64(0xC16D9A00, 0x95928A27), LEPT_U64(0x75B7053C, 0x0F178293) }, /* 1e-23 */
+    { LEPT_U64(0xF1C90080, 0xBAF72CB1), LEPT_U64(0x5324C68B, 0x12DD6338) }, /* 1e-22 */
+    { LEPT_U64(0x971DA050, 0x74DA7BEE), LEPT_U64(0xD3F6FC16, 0xEBCA5E03) }, /* 1e-21 */
+    { LEPT_U64(0xBCE50864, 0x92111AEA), LEPT_U64(0x88F4BB1C, 0xA6BCF584) }, /* 1e-20 */
+    { LEPT_U64(0xEC1E4A7D, 0xB69561A5), LEPT_U64(0x2B31E9E3, 0xD06C32E5) }, /* 1e-19 */
+    { LEPT_U64(0x9392EE8E, 0x921D5D07), LEPT_U64(0x3AFF322E, 0x62439FCF) }, /* 1e-18 */
+    { LEPT_U64(0xB877AA32, 0x36A4B449), LEPT_U64(0x09BEFEB9, 0xFAD487C2) }, /* 1e-17 */
+    { LEPT_U64(0xE69594BE, 0xC44DE15B), LEPT_U64(0x4C2EBE68, 0x7989A9B3) }, /* 1e-16 */
+    { LEPT_U64(0x901D7CF7, 0x3AB0ACD9), LEPT_U64(0x0F9D3701, 0x4BF60A10) }, /* 1e-15 */
+    { LEPT_U64(0xB424DC35, 0x095CD80F), LEPT_U64(0x538484C1, 0x9EF38C94) }, /* 1e-14 */
+    { LEPT_U64(0xE12E1342, 0x4BB40E13), LEPT_U64(0x2865A5F2, 0x06B06FB9) }, /* 1e-13 */
+    { LEPT_U64(0x8CBCCC09, 0x6F5088CB), LEPT_U64(0xF93F87B7, 0x442E45D3) }, /* 1e-12 */
+    { LEPT_U64(0xAFEBFF0B, 0xCB24AAFE), LEPT_U64(0xF78F69A5, 0x1539D748) }, /* 1e-11 */
+    { LEPT_U64(0xDBE6FECE, 0xBDEDD5BE), LEPT_U64(0xB573440E, 0x5A884D1B) }, /* 1e-10 */
+    { LEPT_U64(0x89705F41, 0x36B4A597), LEPT_U64(0x31680A88, 0xF8953030) }, /* 1e-9 */
+    { LEPT_U64(0xABCC7711, 0x8461CEFC), LEPT_U64(0xFDC20D2B, 0x36BA7C3D) }, /* 1e-8 */
+    { LEPT_U64(0xD6BF94D5, 0xE57A42BC), LEPT_U64(0x3D329076, 0x04691B4C) }, /* 1e-7 */
+    { LEPT_U64(0x8637BD05, 0xAF6C69B5), LEPT_U64(0xA63F9A49, 0xC2C1B10F) }, /* 1e-6 */
+    { LEPT_U64(0xA7C5AC47, 0x1B478423), LEPT_U64(0x0FCF80DC, 0x33721D53) }, /* 1e-5 */
+    { LEPT_U64(0xD1B71758, 0xE219652B), LEPT_U64(0xD3C36113, 0x404EA4A8) }, /* 1e-4 */
+    { LEPT_U64(0x83126E97, 0x8D4FDF3B), LEPT_U64(0x645A1CAC, 0x083126E9) }, /* 1e-3 */
+    { LEPT_U64(0xA3D70A3D, 0x70A3D70A), LEPT_U64(0x3D70A3D7, 0x0A3D70A3) }, /* 1e-2 */
+    { LEPT_U64(0xCCCCCCCC, 0xCCCCCCCC), LEPT_U64(0xCCCCCCCC, 0xCCCCCCCC) }, /* 1e-1 */
+    { LEPT_U64(0x80000000, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e0 */
+    { LEPT_U64(0xA0000000, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e1 */
+    { LEPT_U64(0xC8000000, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e2 */
+    { LEPT_U64(0xFA000000, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e3 */
+    { LEPT_U64(0x9C400000, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e4 */
+    { LEPT_U64(0xC3500000, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e5 */
+    { LEPT_U64(0xF4240000, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e6 */
+    { LEPT_U64(0x98968000, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e7 */
+    { LEPT_U64(0xBEBC2000, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e8 */
+    { LEPT_U64(0xEE6B2800, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e9 */
+    { LEPT_U64(0x9502F900, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e10 */
+    { LEPT_U64(0xBA43B740, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e11 */
+    { LEPT_U64(0xE8D4A510, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e12 */
+    { LEPT_U64(0x9184E72A, 0x00000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e13 */
+    { LEPT_U64(0xB5E620F4, 0x80000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e14 */
+    { LEPT_U64(0xE35FA931, 0xA0000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e15 */
+    { LEPT_U64(0x8E1BC9BF, 0x04000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e16 */
+    { LEPT_U64(0xB1A2BC2E, 0xC5000000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e17 */
+    { LEPT_U64(0xDE0B6B3A, 0x76400000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e18 */
+    { LEPT_U64(0x8AC72304, 0x89E80000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e19 */
+    { LEPT_U64(0xAD78EBC5, 0xAC620000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e20 */
+    { LEPT_U64(0xD8D726B7, 0x177A8000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e21 */
+    { LEPT_U64(0x87867832, 0x6EAC9000), LEPT_U64(0x00000000, 0x00000000) }, /* 1e22 */
+    { LEPT_U64(0xA968163F, 0x0A57B400), LEPT_U64(0x00000000, 0x00000000) }, /* 1e23 */
+    { LEPT_U64(0xD3C21BCE, 0xCCEDA100), LEPT_U64(0x00000000, 0x00000000) }, /* 1e24 */
+    { LEPT_U64(0x84595161, 0x401484A0), LEPT_U64(0x00000000, 0x00000000) }, /* 1e25 */
+    { LEPT_U64(0xA56FA5B9, 0x9019A5C8), LEPT_U64(0x00000000, 0x00000000) }, /* 1e26 */
+    { LEPT_U64(0xCECB8F27, 0xF4200F3A), LEPT_U64(0x00000000, 0x00000000) }, /* 1e27 */
+    { LEPT_U64(0x813F3978, 0xF8940984), LEPT_U64(0x40000000, 0x00000000) }, /* 1e28 */
+    { LEPT_U64(0xA18F07D7, 0x36B90BE5), LEPT_U64(0x50000000, 0x00000000) }, /* 1e29 */
+    { LEPT_U64(0xC9F2C9CD, 0x04674EDE), LEPT_U64(0xA4000000, 0x00000000) }, /* 1e30 */
+    { LEPT_U64(0xFC6F7C40, 0x45812296), LEPT_U64(0x4D000000, 0x00000000) }, /* 1e31 */
+    { LEPT_U64(0x9DC5ADA8, 0x2B70B59D), LEPT_U64(0xF0200000, 0x00000000) }, /* 1e32 */
+    { LEPT_U64(0xC5371912, 0x364CE305), LEPT_U64(0x6C280000, 0x00000000) }, /* 1e33 */
+    { LEPT_U64(0xF684DF56, 0xC3E01BC6), LEPT_U64(0xC7320000, 0x00000000) }, /* 1e34 */
+    { LEPT_U64(0x9A130B96, 0x3A6C115C), LEPT_U64(0x3C7F4000, 0x00000000) }, /* 1e35 */
+    { LEPT_U64(0xC097CE7B, 0xC90715B3), LEPT_U64(0x4B9F1000, 0x00000000) }, /* 1e36 */
+    { LEPT_U64(0xF0BDC21A, 0xBB48DB20), LEPT_U64(0x1E86D400, 0x00000000) }, /* 1e37 */
+    { LEPT_U64(0x96769950, 0xB50D88F4), LEPT_U64(0x13144480, 0x00000000) }, /* 1e38 */
+    { LEPT_U64(0xBC143FA4, 0xE250EB31), LEPT_U64(0x17D955A0, 0x00000000) }, /* 1e39 */
+    { LEPT_U64(0xEB194F8E, 0x1AE525FD), LEPT_U64(0x5DCFAB08, 0x00000000) }, /* 1e40 */
+    { LEPT_U64(0x92EFD1B8, 0xD0CF37BE), LEPT_U64(0x5AA1CAE5, 0x00000000) }, /* 1e41 */
+    { LEPT_U64(0xB7ABC627, 0x050305AD), LEPT_U64(0xF14A3D9E, 0x40000000) }, /* 1e42 */
+    { LEPT_U64(0xE596B7B0, 0xC643C719), LEPT_U64(0x6D9CCD05, 0xD0000000) }, /* 1e43 */
+    { LEPT_U64(0x8F7E32CE, 0x7BEA5C6F), LEPT_U64(0xE4820023, 0xA2000000) }, /* 1e44 */
+    { LEPT_U64(0xB35DBF82, 0x1AE4F38B), LEPT_U64(0xDDA2802C, 0x8A800000) }, /* 1e45 */
+    { LEPT_U64(0xE0352F62, 0xA19E306E), LEPT_U64(0xD50B2037, 0xAD200000) }, /* 1e46 */
+    { LEPT_U64(0x8C213D9D, 0xA502DE45), LEPT_U64(0x4526F422, 0xCC340000) }, /* 1e47 */
+    { LEPT_U64(0xAF298D05, 0x0E4395D6), LEPT_U64(0x9670B12B, 0x7F410000) }, /* 1e48 */
+    { LEPT_U64(0xDAF3F046, 0x51D47B4C), LEPT_U64(0x3C0CDD76, 0x5F114000) }, /* 1e49 */
+    { LEPT_U64(0x88D8762B, 0xF324CD0F), LEPT_U64(0xA5880A69, 0xFB6AC800) }, /* 1e50 */
+    { LEPT_U64(0xAB0E93B6, 0xEFEE0053), LEPT_U64(0x8EEA0D04, 0x7A457A00) }, /* 1e51 */
+    { LEPT_U64(0xD5D238A4, 0xABE98068), LEPT_U64(0x72A49045, 0x98D6D880) }, /* 1e52 */
+    { LEPT_U64(0x85A36366, 0xEB71F041), LEPT_U64(0x47A6DA2B, 0x7F864750) }, /* 1e53 */
+    { LEPT_U64(0xA70C3C40, 0xA64E6C51), LEPT_U64(0x999090B6, 0x5F67D924) }, /* 1e54 */
+    { LEPT_U64(0xD0CF4B50, 0xCFE20765), LEPT_U64(0xFFF4B4E3, 0xF741CF6D) }, /* 1e55 */
+    { LEPT_U64(0x82818F12, 0x81ED449F), LEPT_U64(0xBFF8F10E, 0x7A8921A4) }, /* 1e56 */
+    { LEPT_U64(0xA321F2D7, 0x226895C7), LEPT_U64(0xAFF72D52, 0x192B6A0D) }, /* 1e57 */
+    { LEPT_U64(0xCBEA6F8C, 0xEB02BB39), LEPT_U64(0x9BF4F8A6, 0x9F764490) }, /* 1e58 */
+    { LEPT_U64(0xFEE50B70, 0x25C36A08), LEPT_U64(0x02F236D0, 0x4753D5B4) }, /* 1e59 */
+    { LEPT_U64(0x9F4F2726, 0x179A2245), LEPT_U64(0x01D76242, 0x2C946590) }, /* 1e60 */
+    { LEPT_U64(0xC722F0EF, 0x9D80AAD6), LEPT_U64(0x424D3AD2, 0xB7B97EF5) }, /* 1e61 */
+    { LEPT_U64(0xF8EBAD2B, 0x84E0D58B), LEPT_U64(0xD2E08987, 0x65A7DEB2) }, /* 1e62 */
+    { LEPT_U64(0x9B934C3B, 0x330C8577), LEPT_U64(0x63CC55F4, 0x9F88EB2F) }, /* 1e63 */
+    { LEPT_U64(0xC2781F49, 0xFFCFA6D5), LEPT_U64(0x3CBF6B71, 0xC76B25FB) }, /* 1e64 */
+    { LEPT_U64(0xF316271C, 0x7FC3908A), LEPT_U64(0x8BEF464E, 0x3945EF7A) }, /* 1e65 */
+    { LEPT_U64(0x97EDD871, 0xCFDA3A56), LEPT_U64(0x97758BF0, 0xE3CBB5AC) }, /* 1e66 */
+    { LEPT_U64(0xBDE94E8E, 0x43D0C8EC), LEPT_U64(0x3D52EEED, 0x1CBEA317) }, /* 1e67 */
+    { LEPT_U64(0xED63A231, 0xD4C4FB27), LEPT_U64(0x4CA7AAA8, 0x63EE4BDD) }, /* 1e68 */
+    { LEPT_U64(0x945E455F, 0x24FB1CF8), LEPT_U64(0x8FE8CAA9, 0x3E74EF6A) }, /* 1e69 */
+    { LEPT_U64(0xB975D6B6, 0xEE39E436), LEPT_U64(0xB3E2FD53, 0x8E122B44) }, /* 1e70 */
+    { LEPT_U64(0xE7D34C64, 0xA9C85D44), LEPT_U64(0x60DBBCA8, 0x7196B616) }, /* 1e71 */
+    { LEPT_U64(0x90E40FBE, 0xEA1D3A4A), LEPT_U64(0xBC8955E9, 0x46FE31CD) }, /* 1e72 */
+    { LEPT_U64(0xB51D13AE, 0xA4A488DD), LEPT_U64(0x6BABAB63, 0x98BDBE41) }, /* 1e73 */
+    { LEPT_U64(0xE264589A, 0x4DCDAB14), LEPT_U64(0xC696963C, 0x7EED2DD1) }, /* 1e74 */
+    { LEPT_U64(0x8D7EB760, 0x70A08AEC), LEPT_U64(0xFC1E1DE5, 0xCF543CA2) }, /* 1e75 */
+    { LEPT_U64(0xB0DE6538, 0x8CC8ADA8), LEPT_U64(0x3B25A55F, 0x43294BCB) }, /* 1e76 */
+    { LEPT_U64(0xDD15FE86, 0xAFFAD912), LEPT_U64(0x49EF0EB7, 0x13F39EBE) }, /* 1e77 */
+    { LEPT_U64(0x8A2DBF14, 0x2DFCC7AB), LEPT_U64(0x6E356932, 0x6C784337) }, /* 1e78 */
+    { LEPT_U64(0xACB92ED9, 0x397BF996), LEPT_U64(0x49C2C37F, 0x07965404) }, /* 1e79 */
+    { LEPT_U64(0xD7E77A8F, 0x87DAF7FB), LEPT_U64(0xDC33745E, 0xC97BE906) }, /* 1e80 */
+    { LEPT_U64(0x86F0AC99, 0xB4E8DAFD), LEPT_U64(0x69A028BB, 0x3DED71A3) }, /* 1e81 */
+    { LEPT_U64(0xA8ACD7C0, 0x222311BC), LEPT_U64(0xC40832EA, 0x0D68CE0C) }, /* 1e82 */
+    { LEPT_U64(0xD2D80DB0, 0x2AABD62B), LEPT_U64(0xF50A3FA4, 0x90C30190) }, /* 1e83 */
+    { LEPT_U64(0x83C7088E, 0x1AAB65DB), LEPT_U64(0x792667C6, 0xDA79E0FA) }, /* 1e84 */
+    { LEPT_U64(0xA4B8CAB1, 0xA1563F52), LEPT_U64(0x577001B8, 0x91185938) }, /* 1e85 */
+    { LEPT_U64(0xCDE6FD5E, 0x09ABCF26), LEPT_U64(0xED4C0226, 0xB55E6F86) }, /* 1e86 */
+    { LEPT_U64(0x80B05E5A, 0xC60B6178), LEPT_U64(0x544F8158, 0x315B05B4) }, /* 1e87 */
+    { LEPT_U64(0xA0DC75F1, 0x778E39D6), LEPT_U64(0x696361AE, 0x3DB1C721) }, /* 1e88 */
+    { LEPT_U64(0xC913936D, 0xD571C84C), LEPT_U64(0x03BC3A19, 0xCD1E38E9) }, /* 1e89 */
+    { LEPT_U64(0xFB587849, 0x4ACE3A5F), LEPT_U64(0x04AB48A0, 0x4065C723) }, /* 1e90 */
+    { LEPT_U64(0x9D174B2D, 0xCEC0E47B), LEPT_U64(0x62EB0D64, 0x283F9C76) }, /* 1e91 */
+    { LEPT_U64(0xC45D1DF9, 0x42711D9A), LEPT_U64(0x3BA5D0BD, 0x324F8394) }, /* 1e92 */
+    { LEPT_U64(0xF5746577, 0x930D6500), LEPT_U64(0xCA8F44EC, 0x7EE36479) }, /* 1e93 */
+    { LEPT_U64(0x9968BF6A, 0xBBE85F20), LEPT_U64(0x7E998B13, 0xCF4E1ECB) }, /* 1e94 */
+    { LEPT_U64(0xBFC2EF45, 0x6AE276E8), LEPT_U64(0x9E3FEDD8, 0xC321A67E) }, /* 1e95 */
+    { LEPT_U64(0xEFB3AB16, 0xC59B14A2), LEPT_U64(0xC5CFE94E, 0xF3EA101E) }, /* 1e96 */
+    { LEPT_U64(0x95D04AEE, 0x3B80ECE5), LEPT_U64(0xBBA1F1D1, 0x58724A12) }, /* 1e97 */
+    { LEPT_U64(0xBB445DA9, 0xCA61281F), LEPT_U64(0x2A8A6E45, 0xAE8EDC97) }, /* 1e98 */
+    { LEPT_U64(0xEA157514, 0x3CF97226), LEPT_U64(0xF52D09D7, 0x1A3293BD) }, /* 1e99 */
+    { LEPT_U64(0x924D692C, 0xA61BE758), LEPT_U64(0x593C2626, 0x705F9C56) }, /* 1e100 */
+    { LEPT_U64(0xB6E0C377, 0xCFA2E12E), LEPT_U64(0x6F8B2FB0, 0x0C77836C) }, /* 1e101 */
+    { LEPT_U64(0xE498F455, 0xC38B997A), LEPT_U64(0x0B6DFB9C, 0x0F956447) }, /* 1e102 */
+    { LEPT_U64(0x8EDF98B5, 0x9A373FEC), LEPT_U64(0x4724BD41, 0x89BD5EAC) }, /* 1e103 */
+    { LEPT_U64(0xB2977EE3, 0x00C50FE7), LEPT_U64(0x58EDEC91, 0xEC2CB657) }, /* 1e104 */
+    { LEPT_U64(0xDF3D5E9B, 0xC0F653E1), LEPT_U64(0x2F2967B6, 0x6737E3ED) }, /* 1e105 */
+    { LEPT_U64(0x8B865B21, 0x5899F46C), LEPT_U64(0xBD79E0D2, 0x0082EE74) }, /* 1e106 */
+    { LEPT_U64(0xAE67F1E9, 0xAEC07187), LEPT_U64(0xECD85906, 0x80A3AA11) }, /* 1e107 */
+    { LEPT_U64(0xDA01EE64, 0x1A708DE9), LEPT_U64(0xE80E6F48, 0x20CC9495) }, /* 1e108 */
+    { LEPT_U64(0x884134FE, 0x908658B2), LEPT_U64(0x3109058D, 0x147FDCDD) }, /* 1e109 */
+    { LEPT_U64(0xAA51823E, 0x34A7EEDE), LEPT_U64(0xBD4B46F0, 0x599FD415) }, /* 1e110 */
+    { LEPT_U64(0xD4E5E2CD, 0xC1D1EA96), LEPT_U64(0x6C9E18AC, 0x7007C91A) }, /* 1e111 */
+    { LEPT_U64(0x850FADC0, 0x9923329E), LEPT_U64(0x03E2CF6B, 0xC604DDB0) }, /* 1e112 */
+    { LEPT_U64(0xA6539930, 0xBF6BFF45), LEPT_U64(0x84DB8346, 0xB786151C) }, /* 1e113 */
+    { LEPT_U64(0xCFE87F7C, 0xEF46FF16), LEPT_U64(0xE6126418, 0x65679A63) }, /* 1e114 */
+    { LEPT_U64(0x81F14FAE, 0x158C5F6E), LEPT_U64(0x4FCB7E8F, 0x3F60C07E) }, /* 1e115 */
+    { LEPT_U64(0xA26DA399, 0x9AEF7749), LEPT_U64(0xE3BE5E33, 0x0F38F09D) }, /* 1e116 */
+    { LEPT_U64(0xCB090C80, 0x01AB551C), LEPT_U64(0x5CADF5BF, 0xD3072CC5) }, /* 1e117 */
+    { LEPT_U64(0xFDCB4FA0, 0x02162A63), LEPT_U64(0x73D9732F, 0xC7C8F7F6) }, /* 1e118 */
+    { LEPT_U64(0x9E9F11C4, 0x014DDA7E), LEPT_U64(0x2867E7FD, 0xDCDD9AFA) }, /* 1e119 */
+    { LEPT_U64(0xC646D635, 0x01A1511D), LEPT_U64(0xB281E1FD, 0x541501B8) }, /* 1e120 */
+    { LEPT_U64(0xF7D88BC2, 0x4209A565), LEPT_U64(0x1F225A7C, 0xA91A4226) }, /* 1e121 */
+    { LEPT_U64(0x9AE75759, 0x6946075F), LEPT_U64(0x3375788D, 0xE9B06958) }, /* 1e122 */
+    { LEPT_U64(0xC1A12D2F, 0xC3978937), LEPT_U64(0x0052D6B1, 0x641C83AE) }, /* 1e123 */
+    { LEPT_U64(0xF209787B, 0xB47D6B84), LEPT_U64(0xC0678C5D, 0xBD23A49A) }, /* 1e124 */
+    { LEPT_U64(0x9745EB4D, 0x50CE6332), LEPT_U64(0xF840B7BA, 0x963646E0) }, /* 1e125 */
+    { LEPT_U64(0xBD176620, 0xA501FBFF), LEPT_U64(0xB650E5A9, 0x3BC3D898) }, /* 1e126 */
+    { LEPT_U64(0xEC5D3FA8, 0xCE427AFF), LEPT_U64(0xA3E51F13, 0x8AB4CEBE) }, /* 1e127 */
+    { LEPT_U64(0x93BA47C9, 0x80E98CDF), LEPT_U64(0xC66F336C, 0x36B10137) }, /* 1e128 */
+    { LEPT_U64(0xB8A8D9BB, 0xE123F017), LEPT_U64(0xB80B0047, 0x445D4184) }, /* 1e129 */
+    { LEPT_U64(0xE6D3102A, 0xD96CEC1D), LEPT_U64(0xA60DC059, 0x157491E5) }, /* 1e130 */
+    { LEPT_U64(0x9043EA1A, 0xC7E41392), LEPT_U64(0x87C89837, 0xAD68DB2F) }, /* 1e131 */
+    { LEPT_U64(0xB454E4A1, 0x79DD1877), LEPT_U64(0x29BABE45, 0x98C311FB) }, /* 1e132 */
+    { LEPT_U64(0xE16A1DC9, 0xD8545E94), LEPT_U64(0xF4296DD6, 0xFEF3D67A) }, /* 1e133 */
+    { LEPT_U64(0x8CE2529E, 0x2734BB1D), LEPT_U64(0x1899E4A6, 0x5F58660C) }, /* 1e134 */
+    { LEPT_U64(0xB01AE745, 0xB101E9E4), LEPT_U64(0x5EC05DCF, 0xF72E7F8F) }, /* 1e135 */
+    { LEPT_U64(0xDC21A117, 0x1D42645D), LEPT_U64(0x76707543, 0xF4FA1F73) }, /* 1e136 */
+    { LEPT_U64(0x899504AE, 0x72497EBA), LEPT_U64(0x6A06494A, 0x791C53A8) }, /* 1e137 */
+    { LEPT_U64(0xABFA45DA, 0x0EDBDE69), LEPT_U64(0x0487DB9D, 0x17636892) }, /* 1e138 */
+    { LEPT_U64(0xD6F8D750, 0x9292D603), LEPT_U64(0x45A9D284, 0x5D3C42B6) }, /* 1e139 */
+    { LEPT_U64(0x865B8692, 0x5B9BC5C2), LEPT_U64(0x0B8A2392, 0xBA45A9B2) }, /* 1e140 */
+    { LEPT_U64(0xA7F26836, 0xF282B732), LEPT_U64(0x8E6CAC77, 0x68D7141E) }, /* 1e141 */
+    { LEPT_U64(0xD1EF0244, 0xAF2364FF), LEPT_U64(0x3207D795, 0x430CD926) }, /* 1e142 */
+    { LEPT_U64(0x8335616A, 0xED761F1F), LEPT_U64(0x7F44E6BD, 0x49E807B8) }, /* 1e143 */
+    { LEPT_U64(0xA402B9C5, 0xA8D3A6E7), LEPT_U64(0x5F16206C, 0x9C6209A6) }, /* 1e144 */
+    { LEPT_U64(0xCD036837, 0x130890A1), LEPT_U64(0x36DBA887, 0xC37A8C0F) }, /* 1e145 */
+    { LEPT_U64(0x80222122, 0x6BE55A64), LEPT_U64(0xC2494954, 0xDA2C9789) }, /* 1e146 */
+    { LEPT_U64(0xA02AA96B, 0x06DEB0FD), LEPT_U64(0xF2DB9BAA, 0x10B7BD6C) }, /* 1e147 */
+    { LEPT_U64(0xC83553C5, 0xC8965D3D), LEPT_U64(0x6F928294, 0x94E5ACC7) }, /* 1e148 */
+    { LEPT_U64(0xFA42A8B7, 0x3ABBF48C), LEPT_U64(0xCB772339, 0xBA1F17F9) }, /* 1e149 */
+    { LEPT_U64(0x9C69A972, 0x84B578D7), LEPT_U64(0xFF2A7604, 0x14536EFB) }, /* 1e150 */
+    { LEPT_U64(0xC38413CF, 0x25E2D70D), LEPT_U64(0xFEF51385, 0x19684ABA) }, /* 1e151 */
+    { LEPT_U64(0xF46518C2, 0xEF5B8CD1), LEPT_U64(0x7EB25866, 0x5FC25D69) }, /* 1e152 */
+    { LEPT_U64(0x98BF2F79, 0xD5993802), LEPT_U64(0xEF2F773F, 0xFBD97A61) }, /* 1e153 */
+    { LEPT_U64(0xBEEEFB58, 0x4AFF8603), LEPT_U64(0xAAFB550F, 0xFACFD8FA) }, /* 1e154 */
+    { LEPT_U64(0xEEAABA2E, 0x5DBF6784), LEPT_U64(0x95BA2A53, 0xF983CF38) }, /* 1e155 */
+    { LEPT_U64(0x952AB45C, 0xFA97A0B2), LEPT_U64(0xDD945A74, 0x7BF26183) }, /* 1e156 */
+    { LEPT_U64(0xBA756174, 0x393D88DF), LEPT_U64(0x94F97111, 0x9AEEF9E4) }, /* 1e157 */
+    { LEPT_U64(0xE912B9D1, 0x478CEB17), LEPT_U64(0x7A37CD56, 0x01AAB85D) }, /* 1e158 */
+    { LEPT_U64(0x91ABB422, 0xCCB812EE), LEPT_U64(0xAC62E055, 0xC10AB33A) }, /* 1e159 */
+    { LEPT_U64(0xB616A12B, 0x7FE617AA), LEPT_U64(0x577B986B, 0x314D6009) }, /* 1e160 */
+    { LEPT_U64(0xE39C4976, 0x5FDF9D94), LEPT_U64(0xED5A7E85, 0xFDA0B80B) }, /* 1e161 */
+    { LEPT_U64(0x8E41ADE9, 0xFBEBC27D), LEPT_U64(0x14588F13, 0xBE847307) }, /* 1e162 */
+    { LEPT_U64(0xB1D21964, 0x7AE6B31C), LEPT_U64(0x596EB2D8, 0xAE258FC8) }, /* 1e163 */
+    { LEPT_U64(0xDE469FBD, 0x99A05FE3), LEPT_U64(0x6FCA5F8E, 0xD9AEF3BB) }, /* 1e164 */
+    { LEPT_U64(0x8AEC23D6, 0x80043BEE), LEPT_U64(0x25DE7BB9, 0x480D5854) }, /* 1e165 */
+    { LEPT_U64(0xADA72CCC, 0x20054AE9), LEPT_U64(0xAF561AA7, 0x9A10AE6A) }, /* 1e166 */
+    { LEPT_U64(0xD910F7FF, 0x28069DA4), LEPT_U64(0x1B2BA151, 0x8094DA04) }, /* 1e167 */
+    { LEPT_U64(0x87AA9AFF, 0x79042286), LEPT_U64(0x90FB44D2, 0xF05D0842) }, /* 1e168 */
+    { LEPT_U64(0xA99541BF, 0x57452B28), LEPT_U64(0x353A1607, 0xAC744A53) }, /* 1e169 */
+    { LEPT_U64(0xD3FA922F, 0x2D1675F2), LEPT_U64(0x42889B89, 0x97915CE8) }, /* 1e170 */
+    { LEPT_U64(0x847C9B5D, 0x7C2E09B7), LEPT_U64(0x69956135, 0xFEBADA11) }, /* 1e171 */
+    { LEPT_U64(0xA59BC234, 0xDB398C25), LEPT_U64(0x43FAB983, 0x7E699095) }, /* 1e172 */
+    { LEPT_U64(0xCF02B2C2, 0x1207EF2E), LEPT_U64(0x94F967E4, 0x5E03F4BB) }, /* 1e173 */
+    { LEPT_U64(0x8161AFB9, 0x4B44F57D), LEPT_U64(0x1D1BE0EE, 0xBAC278F5) }, /* 1e174 */
+    { LEPT_U64(0xA1BA1BA7, 0x9E1632DC), LEPT_U64(0x6462D92A, 0x69731732) }, /* 1e175 */
+    { LEPT_U64(0xCA28A291, 0x859BBF93), LEPT_U64(0x7D7B8F75, 0x03CFDCFE) }, /* 1e176 */
+    { LEPT_U64(0xFCB2CB35, 0xE702AF78), LEPT_U64(0x5CDA7352, 0x44C3D43E) }, /* 1e177 */
+    { LEPT_U64(0x9DEFBF01, 0xB061ADAB), LEPT_U64(0x3A088813, 0x6AFA64A7) }, /* 1e178 */
+    { LEPT_U64(0xC56BAEC2, 0x1C7A1916), LEPT_U64(0x088AAA18, 0x45B8FDD0) }, /* 1e179 */
+    { LEPT_U64(0xF6C69A72, 0xA3989F5B), LEPT_U64(0x8AAD549E, 0x57273D45) }, /* 1e180 */
+    { LEPT_U64(0x9A3C2087, 0xA63F6399), LEPT_U64(0x36AC54E2, 0xF678864B) }, /* 1e181 */
+    { LEPT_U64(0xC0CB28A9, 0x8FCF3C7F), LEPT_U64(0x84576A1B, 0xB416A7DD) }, /* 1e182 */
+    { LEPT_U64(0xF0FDF2D3, 0xF3C30B9F), LEPT_U64(0x656D44A2, 0xA11C51D5) }, /* 1e183 */
+    { LEPT_U64(0x969EB7C4, 0x7859E743), LEPT_U64(0x9F644AE5, 0xA4B1B325) }, /* 1e184 */
+    { LEPT_U64(0xBC4665B5, 0x96706114), LEPT_U64(0x873D5D9F, 0x0DDE1FEE) }, /* 1e185 */
+    { LEPT_U64(0xEB57FF22, 0xFC0C7959), LEPT_U64(0xA90CB506, 0xD155A7EA) }, /* 1e186 */
+    { LEPT_U64(0x9316FF75, 0xDD87CBD8), LEPT_U64(0x09A7F124, 0x42D588F2) }, /* 1e187 */
+    { LEPT_U64(0xB7DCBF53, 0x54E9BECE), LEPT_U64(0x0C11ED6D, 0x538AEB2F) }, /* 1e188 */
+    { LEPT_U64(0xE5D3EF28, 0x2A242E81), LEPT_U64(0x8F1668C8, 0xA86DA5FA) }, /* 1e189 */
+    { LEPT_U64(0x8FA47579, 0x1A569D10), LEPT_U64(0xF96E017D, 0x694487BC) }, /* 1e190 */
+    { LEPT_U64(0xB38D92D7, 0x60EC4455), LEPT_U64(0x37C981DC, 0xC395A9AC) }, /* 1e191 */
+    { LEPT_U64(0xE070F78D, 0x3927556A), LEPT_U64(0x85BBE253, 0xF47B1417) }, /* 1e192 */
+    { LEPT_U64(0x8C469AB8, 0x43B89562), LEPT_U64(0x93956D74, 0x78CCEC8E) }, /* 1e193 */
+    { LEPT_U64(0xAF584166, 0x54A6BABB), LEPT_U64(0x387AC8D1, 0x970027B2) }, /* 1e194 */
+    { LEPT_U64(0xDB2E51BF, 0xE9D0696A), LEPT_U64(0x06997B05, 0xFCC0319E) }, /* 1e195 */
+    { LEPT_U64(0x88FCF317, 0xF22241E2), LEPT_U64(0x441FECE3, 0xBDF81F03) }, /* 1e196 */
+    { LEPT_U64(0xAB3C2FDD, 0xEEAAD25A), LEPT_U64(0xD527E81C, 0xAD7626C3) }, /* 1e197 */
+    { LEPT_U64(0xD60B3BD5, 0x6A5586F1), LEPT_U64(0x8A71E223, 0xD8D3B074) }, /* 1e198 */
+    { LEPT_U64(0x85C70565, 0x62757456), LEPT_U64(0xF6872D56, 0x67844E49) }, /* 1e199 */
+    { LEPT_U64(0xA738C6BE, 0xBB12D16C), LEPT_U64(0xB428F8AC, 0x016561DB) }, /* 1e200 */
+    { LEPT_U64(0xD106F86E, 0x69D785C7), LEPT_U64(0xE13336D7, 0x01BEBA52) }, /* 1e201 */
+    { LEPT_U64(0x82A45B45, 0x0226B39C), LEPT_U64(0xECC00246, 0x61173473) }, /* 1e202 */
+    { LEPT_U64(0xA34D7216, 0x42B06084), LEPT_U64(0x27F002D7, 0xF95D0190) }, /* 1e203 */
+    { LEPT_U64(0xCC20CE9B, 0xD35C78A5), LEPT_U64(0x31EC038D, 0xF7B441F4) }, /* 1e204 */
+    { LEPT_U64(0xFF290242, 0xC83396CE), LEPT_U64(0x7E670471, 0x75A15271) }, /* 1e205 */
+    { LEPT_U64(0x9F79A169, 0xBD203E41), LEPT_U64(0x0F0062C6, 0xE984D386) }, /* 1e206 */
+    { LEPT_U64(0xC75809C4, 0x2C684DD1), LEPT_U64(0x52C07B78, 0xA3E60868) }, /* 1e207 */
+    { LEPT_U64(0xF92E0C35, 0x37826145), LEPT_U64(0xA7709A56, 0xCCDF8A82) }, /* 1e208 */
+    { LEPT_U64(0x9BBCC7A1, 0x42B17CCB), LEPT_U64(0x88A66076, 0x400BB691) }, /* 1e209 */
+    { LEPT_U64(0xC2ABF989, 0x935DDBFE), LEPT_U64(0x6ACFF893, 0xD00EA435) }, /* 1e210 */
+    { LEPT_U64(0xF356F7EB, 0xF83552FE), LEPT_U64(0x0583F6B8, 0xC4124D43) }, /* 1e211 */
+    { LEPT_U64(0x98165AF3, 0x7B2153DE), LEPT_U64(0xC3727A33, 0x7A8B704A) }, /* 1e212 */
+    { LEPT_U64(0xBE1BF1B0, 0x59E9A8D6), LEPT_U64(0x744F18C0, 0x592E4C5C) }, /* 1e213 */
+    { LEPT_U64(0xEDA2EE1C, 0x7064130C), LEPT_U64(0x1162DEF0, 0x6F79DF73) }, /* 1e214 */
+    { LEPT_U64(0x9485D4D1, 0xC63E8BE7), LEPT_U64(0x8ADDCB56, 0x45AC2BA8) }, /* 1e215 */
+    { LEPT_U64(0xB9A74A06, 0x37CE2EE1), LEPT_U64(0x6D953E2B, 0xD7173692) }, /* 1e216 */
+    { LEPT_U64(0xE8111C87, 0xC5C1BA99), LEPT_U64(0xC8FA8DB6, 0xCCDD0437) }, /* 1e217 */
+    { LEPT_U64(0x910AB1D4, 0xDB9914A0), LEPT_U64(0x1D9C9892, 0x400A22A2) }, /* 1e218 */
+    { LEPT_U64(0xB54D5E4A, 0x127F59C8), LEPT_U64(0x2503BEB6, 0xD00CAB4B) }, /* 1e219 */
+    { LEPT_U64(0xE2A0B5DC, 0x971F303A), LEPT_U64(0x2E44AE64, 0x840FD61D) }, /* 1e220 */
+    { LEPT_U64(0x8DA471A9, 0xDE737E24), LEPT_U64(0x5CEAECFE, 0xD289E5D2) }, /* 1e221 */
+    { LEPT_U64(0xB10D8E14, 0x56105DAD), LEPT_U64(0x7425A83E, 0x872C5F47) }, /* 1e222 */
+    { LEPT_U64(0xDD50F199, 0x6B947518), LEPT_U64(0xD12F124E, 0x28F77719) }, /* 1e223 */
+    { LEPT_U64(0x8A5296FF, 0xE33CC92F), LEPT_U64(0x82BD6B70, 0xD99AAA6F) }, /* 1e224 */
+    { LEPT_U64(0xACE73CBF, 0xDC0BFB7B), LEPT_U64(0x636CC64D, 0x1001550B) }, /* 1e225 */
+    { LEPT_U64(0xD8210BEF, 0xD30EFA5A), LEPT_U64(0x3C47F7E0, 0x5401AA4E) }, /* 1e226 */
+    { LEPT_U64(0x8714A775, 0xE3E95C78), LEPT_U64(0x65ACFAEC, 0x34810A71) }, /* 1e227 */
+    { LEPT_U64(0xA8D9D153, 0x5CE3B396), LEPT_U64(0x7F1839A7, 0x41A14D0D) }, /* 1e228 */
+    { LEPT_U64(0xD31045A8, 0x341CA07C), LEPT_U64(0x1EDE4811, 0x1209A050) }, /* 1e229 */
+    { LEPT_U64(0x83EA2B89, 0x2091E44D), LEPT_U64(0x934AED0A, 0xAB460432) }, /* 1e230 */
+    { LEPT_U64(0xA4E4B66B, 0x68B65D60), LEPT_U64(0xF81DA84D, 0x5617853F) }, /* 1e231 */
+    { LEPT_U64(0xCE1DE406, 0x42E3F4B9), LEPT_U64(0x36251260, 0xAB9D668E) }, /* 1e232 */
+    { LEPT_U64(0x80D2AE83, 0xE9CE78F3), LEPT_U64(0xC1D72B7C, 0x6B426019) }, /* 1e233 */
+    { LEPT_U64(0xA1075A24, 0xE4421730), LEPT_U64(0xB24CF65B, 0x8612F81F) }, /* 1e234 */
+    { LEPT_U64(0xC94930AE, 0x1D529CFC), LEPT_U64(0xDEE033F2, 0x6797B627) }, /* 1e235 */
+    { LEPT_U64(0xFB9B7CD9, 0xA4A7443C), LEPT_U64(0x169840EF, 0x017DA3B1) }, /* 1e236 */
+    { LEPT_U64(0x9D412E08, 0x06E88AA5), LEPT_U64(0x8E1F2895, 0x60EE864E) }, /* 1e237 */
+    { LEPT_U64(0xC491798A, 0x08A2AD4E), LEPT_U64(0xF1A6F2BA, 0xB92A27E2) }, /* 1e238 */
+    { LEPT_U64(0xF5B5D7EC, 0x8ACB58A2), LEPT_U64(0xAE10AF69, 0x6774B1DB) }, /* 1e239 */
+    { LEPT_U64(0x9991A6F3, 0xD6BF1765), LEPT_U64(0xACCA6DA1, 0xE0A8EF29) }, /* 1e240 */
+    { LEPT_U64(0xBFF610B0, 0xCC6EDD3F), LEPT_U64(0x17FD090A, 0x58D32AF3) }, /* 1e241 */
+    { LEPT_U64(0xEFF394DC, 0xFF8A948E), LEPT_U64(0xDDFC4B4C, 0xEF07F5B0) }, /* 1e242 */
+    { LEPT_U64(0x95F83D0A, 0x1FB69CD9), LEPT_U64(0x4ABDAF10, 0x1564F98E) }, /* 1e243 */
+    { LEPT_U64(0xBB764C4C, 0xA7A4440F), LEPT_U64(0x9D6D1AD4, 0x1ABE37F1) }, /* 1e244 */
+    { LEPT_U64(0xEA53DF5F, 0xD18D5513), LEPT_U64(0x84C86189, 0x216DC5ED) }, /* 1e245 */
+    { LEPT_U64(0x92746B9B, 0xE2F8552C), LEPT_U64(0x32FD3CF5, 0xB4E49BB4) }, /* 1e246 */
+    { LEPT_U64(0xB7118682, 0xDBB66A77), LEPT_U64(0x3FBC8C33, 0x221DC2A1) }, /* 1e247 */
+    { LEPT_U64(0xE4D5E823, 0x92A40515), LEPT_U64(0x0FABAF3F, 0xEAA5334A) }, /* 1e248 */
+    { LEPT_U64(0x8F05B116, 0x3BA6832D), LEPT_U64(0x29CB4D87, 0xF2A7400E) }, /* 1e249 */
+    { LEPT_U64(0xB2C71D5B, 0xCA9023F8), LEPT_U64(0x743E20E9, 0xEF511012) }, /* 1e250 */
+    { LEPT_U64(0xDF78E4B2, 0xBD342CF6), LEPT_U64(0x914DA924, 0x6B255416) }, /* 1e251 */
+    { LEPT_U64(0x8BAB8EEF, 0xB6409C1A), LEPT_U64(0x1AD089B6, 0xC2F7548E) }, /* 1e252 */
+    { LEPT_U64(0xAE9672AB, 0xA3D0C320), LEPT_U64(0xA184AC24, 0x73B529B1) }, /* 1e253 */
+    { LEPT_U64(0xDA3C0F56, 0x8CC4F3E8), LEPT_U64(0xC9E5D72D, 0x90A2741E) }, /* 1e254 */
+    { LEPT_U64(0x88658996, 0x17FB1871), LEPT_U64(0x7E2FA67C, 0x7A658892) }, /* 1e255 */
+    { LEPT_U64(0xAA7EEBFB, 0x9DF9DE8D), LEPT_U64(0xDDBB901B, 0x98FEEAB7) }, /* 1e256 */
+    { LEPT_U64(0xD51EA6FA, 0x85785631), LEPT_U64(0x552A7422, 0x7F3EA565) }, /* 1e257 */
+    { LEPT_U64(0x8533285C, 0x936B35DE), LEPT_U64(0xD53A8895, 0x8F87275F) }, /* 1e258 */
+    { LEPT_U64(0xA67FF273, 0xB8460356), LEPT_U64(0x8A892ABA, 0xF368F137) }, /* 1e259 */
+    { LEPT_U64(0xD01FEF10, 0xA657842C), LEPT_U64(0x2D2B7569, 0xB0432D85) }, /* 1e260 */
+    { LEPT_U64(0x8213F56A, 0x67F6B29B), LEPT_U64(0x9C3B2962, 0x0E29FC73) }, /* 1e261 */
+    { LEPT_U64(0xA298F2C5, 0x01F45F42), LEPT_U64(0x8349F3BA, 0x91B47B8F) }, /* 1e262 */
+    { LEPT_U64(0xCB3F2F76, 0x42717713), LEPT_U64(0x241C70A9, 0x36219A73) }, /* 1e263 */
+    { LEPT_U64(0xFE0EFB53, 0xD30DD4D7), LEPT_U64(0xED238CD3, 0x83AA0110) }, /* 1e264 */
+    { LEPT_U64(0x9EC95D14, 0x63E8A506), LEPT_U64(0xF4363804, 0x324A40AA) }, /* 1e265 */
+    { LEPT_U64(0xC67BB459, 0x7CE2CE48), LEPT_U64(0xB143C605, 0x3EDCD0D5) }, /* 1e266 */
+    { LEPT_U64(0xF81AA16F, 0xDC1B81DA), LEPT_U64(0xDD94B786, 0x8E94050A) }, /* 1e267 */
+    { LEPT_U64(0x9B10A4E5, 0xE9913128), LEPT_U64(0xCA7CF2B4, 0x191C8326) }, /* 1e268 */
+    { LEPT_U64(0xC1D4CE1F, 0x63F57D72), LEPT_U64(0xFD1C2F61, 0x1F63A3F0) }, /* 1e269 */
+    { LEPT_U64(0xF24A01A7, 0x3CF2DCCF), LEPT_U64(0xBC633B39, 0x673C8CEC) }, /* 1e270 */
+    { LEPT_U64(0x976E4108, 0x8617CA01), LEPT_U64(0xD5BE0503, 0xE085D813) }, /* 1e271 */
+    { LEPT_U64(0xBD49D14A, 0xA79DBC82), LEPT_U64(0x4B2D8644, 0xD8A74E18) }, /* 1e272 */
+    { LEPT_U64(0xEC9C459D, 0x51852BA2), LEPT_U64(0xDDF8E7D6, 0x0ED1219E) }, /* 1e273 */
+    { LEPT_U64(0x93E1AB82, 0x52F33B45), LEPT_U64(0xCABB90E5, 0xC942B503) }, /* 1e274 */
+    { LEPT_U64(0xB8DA1662, 0xE7B00A17), LEPT_U64(0x3D6A751F, 0x3B936243) }, /* 1e275 */
+    { LEPT_U64(0xE7109BFB, 0xA19C0C9D), LEPT_U64(0x0CC51267, 0x0A783AD4) }, /* 1e276 */
+    { LEPT_U64(0x906A617D, 0x450187E2), LEPT_U64(0x27FB2B80, 0x668B24C5) }, /* 1e277 */
+    { LEPT_U64(0xB484F9DC, 0x9641E9DA), LEPT_U64(0xB1F9F660, 0x802DEDF6) }, /* 1e278 */
+    { LEPT_U64(0xE1A63853, 0xBBD26451), LEPT_U64(0x5E7873F8, 0xA0396973) }, /* 1e279 */
+    { LEPT_U64(0x8D07E334, 0x55637EB2), LEPT_U64(0xDB0B487B, 0x6423E1E8) }, /* 1e280 */
+    { LEPT_U64(0xB049DC01, 0x6ABC5E5F), LEPT_U64(0x91CE1A9A, 0x3D2CDA62) }, /* 1e281 */
+    { LEPT_U64(0xDC5C5301, 0xC56B75F7), LEPT_U64(0x7641A140, 0xCC7810FB) }, /* 1e282 */
+    { LEPT_U64(0x89B9B3E1, 0x1B6329BA), LEPT_U64(0xA9E904C8, 0x7FCB0A9D) }, /* 1e283 */
+    { LEPT_U64(0xAC2820D9, 0x623BF429), LEPT_U64(0x546345FA, 0x9FBDCD44) }, /* 1e284 */
+    { LEPT_U64(0xD732290F, 0xBACAF133), LEPT_U64(0xA97C1779, 0x47AD4095) }, /* 1e285 */
+    { LEPT_U64(0x867F59A9, 0xD4BED6C0), LEPT_U64(0x49ED8EAB, 0xCCCC485D) }, /* 1e286 */
+    { LEPT_U64(0xA81F3014, 0x49EE8C70), LEPT_U64(0x5C68F256, 0xBFFF5A74) }, /* 1e287 */
+    { LEPT_U64(0xD226FC19, 0x5C6A2F8C), LEPT_U64(0x73832EEC, 0x6FFF3111) }, /* 1e288 */
+    { LEPT_U64(0x83585D8F, 0xD9C25DB7), LEPT_U64(0xC831FD53, 0xC5FF7EAB) }, /* 1e289 */
+    { LEPT_U64(0xA42E74F3, 0xD032F525), LEPT_U64(0xBA3E7CA8, 0xB77F5E55) }, /* 1e290 */
+    { LEPT_U64(0xCD3A1230, 0xC43FB26F), LEPT_U64(0x28CE1BD2, 0xE55F35EB) }, /* 1e291 */
+    { LEPT_U64(0x80444B5E, 0x7AA7CF85), LEPT_U64(0x7980D163, 0xCF5B81B3) }, /* 1e292 */
+    { LEPT_U64(0xA0555E36, 0x1951C366), LEPT_U64(0xD7E105BC, 0xC332621F) }, /* 1e293 */
+    { LEPT_U64(0xC86AB5C3, 0x9FA63440), LEPT_U64(0x8DD9472B, 0xF3FEFAA7) }, /* 1e294 */
+    { LEPT_U64(0xFA856334, 0x878FC150), LEPT_U64(0xB14F98F6, 0xF0FEB951) }, /* 1e295 */
+    { LEPT_U64(0x9C935E00, 0xD4B9D8D2), LEPT_U64(0x6ED1BF9A, 0x569F33D3) }, /* 1e296 */
+    { LEPT_U64(0xC3B83581, 0x09E84F07), LEPT_U64(0x0A862F80, 0xEC4700C8) }, /* 1e297 */
+    { LEPT_U64(0xF4A642E1, 0x4C6262C8), LEPT_U64(0xCD27BB61, 0x2758C0FA) }, /* 1e298 */
+    { LEPT_U64(0x98E7E9CC, 0xCFBD7DBD), LEPT_U64(0x8038D51C, 0xB897789C) }, /* 1e299 */
+    { LEPT_U64(0xBF21E440, 0x03ACDD2C), LEPT_U64(0xE0470A63, 0xE6BD56C3) }, /* 1e300 */
+    { LEPT_U64(0xEEEA5D50, 0x04981478), LEPT_U64(0x1858CCFC, 0xE06CAC74) }, /* 1e301 */
+    { LEPT_U64(0x95527A52, 0x02DF0CCB), LEPT_U64(0x0F37801E, 0x0C43EBC8) }, /* 1e302 */
+    { LEPT_U64(0xBAA718E6, 0x8396CFFD), LEPT_U64(0xD3056025, 0x8F54E6BA) }, /* 1e303 */
+    { LEPT_U64(0xE950DF20, 0x247C83FD), LEPT_U64(0x47C6B82E, 0xF32A2069) }, /* 1e304 */
+    { LEPT_U64(0x91D28B74, 0x16CDD27E), LEPT_U64(0x4CDC331D, 0x57FA5441) }, /* 1e305 */
+    { LEPT_U64(0xB6472E51, 0x1C81471D), LEPT_U64(0xE0133FE4, 0xADF8E952) }, /* 1e306 */
+    { LEPT_U64(0xE3D8F9E5, 0x63A198E5), LEPT_U64(0x58180FDD, 0xD97723A6) }, /* 1e307 */
+    { LEPT_U64(0x8E679C2F, 0x5E44FF8F), LEPT_U64(0x570F09EA, 0xA7EA7648) }  /* 1e308 */
+};
+
+static const double lept_pow10_exact[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static void lept_mul64(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 r = (unsigned __int128)a * b;
+    *hi = (uint64_t)(r >> 64);
+    *lo = (uint64_t)r;
+#else
+    uint64_t a0 = a & 0xFFFFFFFF, a1 = a >> 32, b0 = b & 0xFFFFFFFF, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    *lo = (mid << 32) | (p00 & 0xFFFFFFFF);
+#endif
+}
+
+static int lept_clz64(uint64_t x) {
+    int n = 0;
+    assert(x != 0);
+#if defined(__GNUC__)
+    n = __builtin_clzll(x);
+#else
+    while (!(x & LEPT_U64(0x80000000, 0))) {
+        x <<= 1;
+        n++;
+    }
+#endif
+    return n;
+}
+
+/* Returns 0 when the result cannot be decided here (ambiguous rounding, subnormal or overflow). */
+static int lept_eisel_lemire(uint64_t w, int q, double* d) {
+    const uint64_t* pow10;
+    uint64_t hi, lo, mantissa, bits;
+    long exp2;
+    int lz, msb;
+    assert(w != 0 && q >= LEPT_POW10_MIN_EXP10 && q <= LEPT_POW10_MAX_EXP10);
+    pow10 = lept_pow10_128[q - LEPT_POW10_MIN_EXP10];
+    lz = lept_clz64(w);
+    w <<= lz;
+    /* biased binary exponent: floor(q * log2(10)) + 64 + 1023 - lz */
+    exp2 = (q >= 0 ? (217706L * q) >> 16 : -((-217706L * q + 65535) >> 16)) + 64 + 1023 - lz;
+    lept_mul64(w, pow10[0], &hi, &lo);
+    if ((hi & 0x1FF) == 0x1FF && lo + w < w) {
+        /* the truncated low word of 10^q may carry into the bits that matter */
+        uint64_t hi2, lo2;
+        lept_mul64(w, pow10[1], &hi2, &lo2);
+        lo += hi2;
+        if (lo < hi2)
+            hi++;
+        if ((hi & 0x1FF) == 0x1FF && lo + 1 == 0 && lo2 + w < w)
+            return 0;
+    }
+    msb = (int)(hi >> 63);
+    mantissa = hi >> (msb + 9);
+    exp2 -= 1 ^ msb;
+    if (lo == 0 && (hi & 0x1FF) == 0 && (mantissa & 3) == 1)
+        return 0; /* exactly half-way, the discarded bits decide */
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >> 53) {
+        mantissa >>= 1;
+        exp2++;
+    }
+    if (exp2 <= 0 || exp2 >= 0x7FF)
+        return 0;
+    bits = ((uint64_t)exp2 << 52) | (mantissa & LEPT_U64(0x000FFFFF, 0xFFFFFFFF));
+    memcpy(d, &bits, sizeof(double));
+    return 1;
+}
+
+/*
+ * Slow path: the number as a decimal 0.d[0]d[1]...d[nd-1] * 10^dp, exact up
+ * to 800 digits, which is more than a double ever needs to round correctly;
+ * trunc records non-zero digits dropped beyond them.
+ */
+#define LEPT_DECIMAL_DIGITS 800
+#define LEPT_DECIMAL_MAX_SHIFT 60   /* a digit shifted this far, plus carries, fits 64 bits */
+
+/* A decimal exponent stops growing here, beyond what the digit count of any text short of 100 MB can offset. */
+#define LEPT_EXP10_SATURATE 100000000L
+
+typedef struct {
+    int nd, dp, trunc;
+    unsigned char d[LEPT_DECIMAL_DIGITS + 20];  /* digit values, room for one left shift */
+}lept_decimal;
+
+static void lept_decimal_trim(lept_decimal* a) {
+    while (a->nd > 0 && a->d[a->nd - 1] == 0)
+        a->nd--;
+    if (a->nd == 0)
+        a->dp = 0;
+}
+
+static void lept_decimal_left_shift(lept_decimal* a, int k) {
+    /* 2^k adds at most k * 0.3047 + 1 digits: write from the right, then move down */
+    int r = a->nd, end = a->nd + (k * 78 >> 8) + 1, w = end;
+    uint64_t n = 0;
+    while (--r >= 0) {
+        n += (uint64_t)a->d[r] << k;
+        a->d[--w] = (unsigned char)(n % 10);
+        n /= 10;
+    }
+    for (; n > 0; n /= 10)
+        a->d[--w] = (unsigned char)(n % 10);
+    memmove(a->d, a->d + w, end - w);
+    a->dp += end - w - a->nd;
+    a->nd = end - w;
+    if (a->nd > LEPT_DECIMAL_DIGITS) {
+        for (r = LEPT_DECIMAL_DIGITS; r < a->nd; r++)
+            a->trunc |= a->d[r] != 0;
+        a->nd = LEPT_DECIMAL_DIGITS;
+    }
+    lept_decimal_trim(a);
+}
+
+static void lept_decimal_right_shift(lept_decimal* a, int k) {
+    int r = 0, w = 0;
+    uint64_t n = 0, mask = ((uint64_t)1 << k) - 1;
+    /* pick up enough leading digits to cover the first shift */
+    for (; n >> k == 0; r++) {
+        if (r >= a->nd) {
+            if (n == 0) {
+                a->nd = 0;
+                return;
+            }
+            for (; n >> k == 0; r++)
+                n *= 10;
+            break;
+        }
+        n = n * 10 + a->d[r];
+    }
+    a->dp -= r - 1;
+    /* pick up a digit, put down a digit */
+    for (; r < a->nd; r++) {
+        a->d[w++] = (unsigned char)(n >> k);
+        n = (n & mask) * 10 + a->d[r];
+    }
+    /* put down the remaining ones */
+    for (; n > 0; n = (n & mask) * 10) {
+        if (w < LEPT_DECIMAL_DIGITS)
+            a->d[w++] = (unsigned char)(n >> k);
+        else if (n >> k > 0)
+            a->trunc = 1;
+    }
+    a->nd = w;
+    lept_decimal_trim(a);
+}
+
+static void lept_decimal_shift(lept_decimal* a, int k) {
+    for (; k > LEPT_DECIMAL_MAX_SHIFT; k -= LEPT_DECIMAL_MAX_SHIFT)
+        lept_decimal_left_shift(a, LEPT_DECIMAL_MAX_SHIFT);
+    for (; k < -LEPT_DECIMAL_MAX_SHIFT; k += LEPT_DECIMAL_MAX_SHIFT)
+        lept_decimal_right_shift(a, LEPT_DECIMAL_MAX_SHIFT);
+    if (k > 0)
+        lept_decimal_left_shift(a, k);
+    else if (k < 0)
+        lept_decimal_right_shift(a, -k);
+}
+
+/* The integer part, rounded half to even (up if non-zero digits were dropped); a->dp <= 20. */
+static uint64_t lept_decimal_round(const lept_decimal* a) {
+    uint64_t n = 0;
+    int i, up;
+    for (i = 0; i < a->dp; i++)
+        n = n * 10 + (i < a->nd ? a->d[i] : 0);
+    if (a->dp < 0 || a->dp >= a->nd)
+        up = 0;
+    else if (a->d[a->dp] == 5 && a->dp + 1 == a->nd)
+        up = a->trunc || (n & 1);
+    else
+        up = a->d[a->dp] >= 5;
+    return n + up;
+}
+
+/*
+ * The double nearest to the number in [p, end), its sign ignored; sets
+ * *overflow when that is out of range. The caller checked the grammar.
+ */
+static double lept_decimal_to_double(const char* p, const char* end, int* overflow) {
+    /* a shift by powtab[n] bits moves dp by about n */
+    static const int powtab[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+    lept_decimal a;
+    uint64_t mantissa, bits;
+    int exp2 = 0, dot = 0, n;
+    long e = 0, dp;
+    double d;
+    a.nd = a.dp = a.trunc = 0;
+    *overflow = 0;
+    if (*p == '-')
+        p++;
+    for (; p < end && (ISDIGIT(*p) || *p == '.'); p++) {
+        if (*p == '.') {
+            dot = 1;
+            a.dp = a.nd;
+        }
+        else if (*p == '0' && a.nd == 0)
+            a.dp--; /* leading zeros */
+        else if (a.nd < LEPT_DECIMAL_DIGITS)
+            a.d[a.nd++] = (unsigned char)(*p - '0');
+        else
+            a.trunc |= *p != '0';
+    }
+    if (!dot)
+        a.dp = a.nd;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        int esign = 1;
+        if (*++p == '+')
+            p++;
+        else if (*p == '-') {
+            esign = -1;
+            p++;
+        }
+        for (; p < end && ISDIGIT(*p); p++)
+            if (e < LEPT_EXP10_SATURATE)
+                e = e * 10 + (*p - '0');
+        /* clamped only once combined with the digit count, far outside the range of a double */
+        dp = a.dp + esign * e;
+        a.dp = dp > 100000 ? 100000 : dp < -100000 ? -100000 : (int)dp;
+    }
+    lept_decimal_trim(&a);
+    if (a.nd == 0 || a.dp < -330)
+        return 0.0;
+    if (a.dp > 310) {
+        *overflow = 1;
+        return HUGE_VAL;
+    }
+    /* scale into [0.5, 1), counting the binary exponent */
+    while (a.dp > 0) {
+        n = a.dp >= 9 ? 27 : powtab[a.dp];
+        lept_decimal_shift(&a, -n);
+        exp2 += n;
+    }
+    while (a.dp < 0 || (a.dp == 0 && a.d[0] < 5)) {
+        n = -a.dp >= 9 ? 27 : powtab[-a.dp];
+        lept_decimal_shift(&a, n);
+        exp2 -= n;
+    }
+    exp2--; /* into [1, 2) */
+    if (exp2 < -1022) {
+        /* subnormal: the excess exponent goes into the mantissa */
+        lept_decimal_shift(&a, exp2 + 1022);
+        exp2 = -1022;
+    }
+    if (exp2 > 1023) {
+        *overflow = 1;
+        return HUGE_VAL;
+    }
+    lept_decimal_shift(&a, 53);
+    mantissa = lept_decimal_round(&a);
+    if (mantissa == (uint64_t)2 << 52) {
+        /* rounding carried into a new bit */
+        mantissa >>= 1;
+        if (++exp2 > 1023) {
+            *overflow = 1;
+            return HUGE_VAL;
+        }
+    }
+    if (!(mantissa >> 52))
+        exp2 = -1023; /* subnormal */
+    bits = ((uint64_t)(exp2 + 1023) << 52) | (mantissa & LEPT_U64(0x000FFFFF, 0xFFFFFFFF));
+    memcpy(&d, &bits, sizeof(double));
+    return d;
+}
+
+static int lept_parse_number(lept_context* c, lept_value* v) {
+    const char* p = c->json;
+    uint64_t w = 0, u;
+    long q = 0, e = 0;
+    int neg = 0, esign = 1, digits = 0, truncated = 0;
+    double d, d2;
+    char ch;
+    if (AT(c, p) == '-') { neg = 1; p++; }
+    if (AT(c, p) == '0') p++;
+    else {
+        if (!ISDIGIT1TO9(AT(c, p))) return LEPT_PARSE_INVALID_VALUE;
+        for (; p < c->end && ISDIGIT(*p); p++) {
+            if (digits < 19) {
+                w = w * 10 + (*p - '0');
+                digits++;
+            }
+            else {
+                q++;
+                truncated |= *p != '0';
+            }
+        }
+    }
+    ch = AT(c, p);
+    if (ch != '.' && ch != 'e' && ch != 'E' && q <= 1 && (w != 0 || !neg)) {
+        /* an integer literal that fits 64 bits keeps its exact value; "-0" stays a double.
+           w and q are left alone until it does, the double path still needs them. */
+        u = w;
+        if (q == 1) {
+            unsigned last = (unsigned)(p[-1] - '0');
+            if (w > LEPT_U64(0x19999999, 0x99999999) || (w == LEPT_U64(0x19999999, 0x99999999) && last > 5))
+                goto fraction; /* above UINT64_MAX */
+            u = w * 10 + last;
+        }
+        if (!neg) {
+            v->u.u64 = u;
+            v->flags = u >> 63 ? LEPT_FLAG_UINT64 : LEPT_FLAG_INT64;
+        }
+        else if (u <= LEPT_U64(0x80000000, 0)) {
+            v->u.i64 = -(int64_t)(u - 1) - 1;
+            v->flags = LEPT_FLAG_INT64;
+        }
+        else
+            goto fraction; /* below INT64_MIN */
+        v->type = LEPT_NUMBER;
+        c->json = p;
+        return LEPT_PARSE_OK;
+    }
+fraction:
+    if (AT(c, p) == '.') {
+        p++;
+        if (!ISDIGIT(AT(c, p))) return LEPT_PARSE_INVALID_VALUE;
+        for (; p < c->end && ISDIGIT(*p); p++) {
+            if (digits < 19) {
+                w = w * 10 + (*p - '0');
+                digits += w != 0; /* leading zeros of the fraction are not significant */
+                q--;
+            }
+            else
+                truncated |= *p != '0';
+        }
+    }
+    if (AT(c, p) == 'e' || AT(c, p) == 'E') {
+        p++;
+        if (AT(c, p) == '+') p++;
+        else if (AT(c, p) == '-') { esign = -1; p++; }
+        if (!ISDIGIT(AT(c, p))) return LEPT_PARSE_INVALID_VALUE;
+        for (; p < c->end && ISDIGIT(*p); p++)
+            if (e < LEPT_EXP10_SATURATE)
+                e = e * 10 + (*p - '0');
+    }
+    q += esign * e; /* checked against the range of a double only now */
+    if (w == 0)
+        d = 0.0;
+    else if (q > LEPT_POW10_MAX_EXP10)
+        return LEPT_PARSE_NUMBER_TOO_BIG;
+    else if (q < LEPT_POW10_MIN_EXP10)
+        d = 0.0; /* below half of the smallest subnormal even with 19 digits */
+    else if (!truncated && w <= LEPT_U64(0x00200000, 0) && q >= -22 && q <= 22)
+        d = q < 0 ? (double)w / lept_pow10_exact[-q] : (double)w * lept_pow10_exact[q];
+    else if (!(lept_eisel_lemire(w, (int)q, &d) && (!truncated || (lept_eisel_lemire(w + 1, (int)q, &d2) && d == d2)))) {
+        /* the digits dropped beyond 19 lie between w and w + 1, both must round the same way */
+        int overflow;
+        d = lept_decimal_to_double(c->json, p, &overflow);
+        if (overflow)
+            return LEPT_PARSE_NUMBER_TOO_BIG;
+    }
+    v->u.n = neg ? -d : d;
+    v->type = LEPT_NUMBER;
+    c->json = p;
+    return LEPT_PARSE_OK;
+}
+
+static const char* lept_parse_hex4(const char* p, const char* end, unsigned* u) {
+    int i;
+    *u = 0;
+    if (end - p < 4)
+        return NULL;
+    for (i = 0; i < 4; i++) {
+        char ch = *p++;
+        *u <<= 4;
+        if      (ch >= '0' && ch <= '9')  *u |= ch - '0';
+        else if (ch >= 'A' && ch <= 'F')  *u |= ch - ('A' - 10);
+        else if (ch >= 'a' && ch <= 'f')  *u |= ch - ('a' - 10);
+        else return NULL;
+    }
+    return p;
+}
+
+/* In-situ decoding never outgrows the source: every escape is longer than its UTF-8 encoding. */
+#define STRING_PUTC(c, ch)  do { if (c->insitu) *c->dst++ = (char)(ch); else PUTC(c, ch); } while(0)
+
+static void lept_encode_utf8(lept_context* c, unsigned u) {
+    if (u <= 0x7F) 
+        STRING_PUTC(c, u & 0xFF);
+    else if (u <= 0x7FF) {
+        STRING_PUTC(c, 0xC0 | ((u >> 6) & 0xFF));
+        STRING_PUTC(c, 0x80 | ( u       & 0x3F));
+    }
+    else if (u <= 0xFFFF) {
+        STRING_PUTC(c, 0xE0 | ((u >> 12) & 0xFF));
+        STRING_PUTC(c, 0x80 | ((u >>  6) & 0x3F));
+        STRING_PUTC(c, 0x80 | ( u        & 0x3F));
+    }
+    else {
+        assert(u <= 0x10FFFF);
+        STRING_PUTC(c, 0xF0 | ((u >> 18) & 0xFF));
+        STRING_PUTC(c, 0x80 | ((u >> 12) & 0x3F));
+        STRING_PUTC(c, 0x80 | ((u >>  6) & 0x3F));
+        STRING_PUTC(c, 0x80 | ( u        & 0x3F));
+    }
+}
+
+#define STRING_ERROR(ret) do { c->top = head; return ret; } while(0)
+
+static int lept_parse_string_raw(lept_context* c, char** str, size_t* len) {
+    size_t head = c->top;
+    unsigned u, u2;
+    const char* p;
+    EXPECT(c, '\"');
+    p = c->json;
+    c->dst = (char*)p;
+    for (;;) {
+        /* with the index, the next entry is the next quote, escape or control character */
+        const char* q = c->index != NULL ? lept_index_seek(c, p) : lept_scan_string(c, p);
+        char ch;
+        if (q != p) {
+            if (c->utf8 && !lept_utf8_valid(p, q))
+                STRING_ERROR(LEPT_PARSE_INVALID_UTF8);
+            if (!c->insitu)
+                PUTS(c, p, q - p);
+            else {
+                if (c->dst != p)
+                    memmove(c->dst, p, q - p);
+                c->dst += q - p;
+            }
+            p = q;
+        }
+        if (p == c->end)
+            STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
+        switch (ch = *p++) {
+            case '\"':
+                if (c->insitu) {
+                    *str = (char*)c->json;
+                    *len = c->dst - *str;
+                    *c->dst = '\0';
+                }
+                else {
+                    *len = c->top - head;
+                    *str = lept_context_pop(c, *len);
+                }
+                c->json = p;
+                return LEPT_PARSE_OK;
+            case '\\':
+                ch = AT(c, p);
+                p++;
+                switch (ch) {
+                    case '\"': STRING_PUTC(c, '\"'); break;
+                    case '\\': STRING_PUTC(c, '\\'); break;
+                    case '/':  STRING_PUTC(c, '/' ); break;
+                    case 'b':  STRING_PUTC(c, '\b'); break;
+                    case 'f':  STRING_PUTC(c, '\f'); break;
+                    case 'n':  STRING_PUTC(c, '\n'); break;
+                    case 'r':  STRING_PUTC(c, '\r'); break;
+                    case 't':  STRING_PUTC(c, '\t'); break;
+                    case 'u':
+                        if (!(p = lept_parse_hex4(p, c->end, &u)))
+                            STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
+                        if (u >= 0xD800 && u <= 0xDBFF) { /* surrogate pair */
+                            if (AT(c, p) != '\\' || AT(c, p + 1) != 'u')
+                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
+                            if (!(p = lept_parse_hex4(p + 2, c->end, &u2)))
+                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
+                            if (u2 < 0xDC00 || u2 > 0xDFFF)
+                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
+                            u = (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
+                        }
+                        lept_encode_utf8(c, u);
+                        break;
+                    default:
+                        STRING_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE);
+                }
+                break;
+            default:
+                if ((unsigned char)ch < 0x20)
+                    STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
+                STRING_PUTC(c, ch);
+        }
+    }
+}
+
+/*
+ * The grammar is walked once, by lept_parse_events(), which reports what it
+ * finds to a lept_handler. Arrays and objects are parsed without recursion:
+ * the open containers are kept in a byte stack of '[' and '{'.
+ */
+#define EVENT(f, args)      ((f) != NULL ? (f)args : LEPT_PARSE_OK)
+
+static int lept_parse_event_key(lept_context* c, const lept_handler* h, void* ud) {
+    char* str;
+    size_t len;
+    int ret;
+    if (PEEK(c) != '"')
+        return LEPT_PARSE_MISS_KEY;
+    if ((ret = lept_parse_string_raw(c, &str, &len)) != LEPT_PARSE_OK)
+        return ret;
+    if ((ret = EVENT(h->key, (ud, str, len))) != LEPT_PARSE_OK)
+        return ret;
+    lept_parse_whitespace(c);
+    if (PEEK(c) != ':')
+        return LEPT_PARSE_MISS_COLON;
+    c->json++;
+    lept_parse_whitespace(c);
+    return LEPT_PARSE_OK;
+}
+
+static int lept_parse_event_scalar(lept_context* c, const lept_handler* h, void* ud) {
+    lept_value e;
+    char* str;
+    size_t len;
+    int ret;
+    switch (PEEK(c)) {
+        case 't':
+            if ((ret = lept_parse_literal(c, &e, "true", LEPT_TRUE)) != LEPT_PARSE_OK)
+                return ret;
+            return EVENT(h->boolean, (ud, 1));
+        case 'f':
+            if ((ret = lept_parse_literal(c, &e, "false", LEPT_FALSE)) != LEPT_PARSE_OK)
+                return ret;
+            return EVENT(h->boolean, (ud, 0));
+        case 'n':
+            if ((ret = lept_parse_literal(c, &e, "null", LEPT_NULL)) != LEPT_PARSE_OK)
+                return ret;
+            return EVENT(h->null, (ud));
+        case '"':
+            if ((ret = lept_parse_string_raw(c, &str, &len)) != LEPT_PARSE_OK)
+                return ret;
+            return EVENT(h->string, (ud, str, len));
+        case '\0':
+            return LEPT_PARSE_EXPECT_VALUE;
+        default:
+            lept_init(&e);
+            if ((ret = lept_parse_number(c, &e)) != LEPT_PARSE_OK)
+                return ret;
+            if ((e.flags & LEPT_FLAG_INT64) && h->int64 != NULL)
+                return h->int64(ud, e.u.i64);
+            if ((e.flags & LEPT_FLAG_UINT64) && h->uint64 != NULL)
+                return h->uint64(ud, e.u.u64);
+            return EVENT(h->number, (ud, lept_get_number(&e)));
+    }
+}
+
+static int lept_parse_events(lept_context* c, const lept_handler* h, void* ud) {
+    char small[64], *levels = small;
+    size_t capacity = sizeof(small);
+    int ret;
+    for (;;) {
+        /* parse a scalar, or open a container and go on with its first child */
+        char ch = PEEK(c);
+        if (ch == '[' || ch == '{') {
+            if (c->depth == c->max_depth) {
+                ret = LEPT_PARSE_DEPTH_EXCEEDED;
+                break;
+            }
+            if (c->depth == capacity) {
+                char* p = (char*)malloc(capacity *= 2);
+                memcpy(p, levels, c->depth);
+                if (levels != small)
+                    free(levels);
+                levels = p;
+            }
+            levels[c->depth++] = ch;
+            if ((ret = ch == '[' ? EVENT(h->start_array, (ud)) : EVENT(h->start_object, (ud))) != LEPT_PARSE_OK)
+                break;
+            c->json++;
+            lept_parse_whitespace(c);
+            if (PEEK(c) != (ch == '[' ? ']' : '}')) {
+                if (ch == '{' && (ret = lept_parse_event_key(c, h, ud)) != LEPT_PARSE_OK)
+                    break;
+                continue;
+            }
+            c->json++;
+            c->depth--;
+            ret = ch == '[' ? EVENT(h->end_array, (ud)) : EVENT(h->end_object, (ud));
+        }
+        else
+            ret = lept_parse_event_scalar(c, h, ud);
+        if (ret != LEPT_PARSE_OK)
+            break;
+        /* a value is complete: close every container that ends here */
+        while (c->depth > 0) {
+            ch = levels[c->depth - 1];
+            lept_parse_whitespace(c);
+            if (PEEK(c) == ',') {
+                c->json++;
+                lept_parse_whitespace(c);
+                ret = ch == '{' ? lept_parse_event_key(c, h, ud) : LEPT_PARSE_OK;
+                break;
+            }
+            else if (PEEK(c) == (ch == '[' ? ']' : '}')) {
+                c->json++;
+                c->depth--;
+                if ((ret = ch == '[' ? EVENT(h->end_array, (ud)) : EVENT(h->end_object, (ud))) != LEPT_PARSE_OK)
+                    break;
+            }
+            else {
+                ret = ch == '[' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+                break;
+            }
+        }
+        if (ret != LEPT_PARSE_OK || c->depth == 0)
+            break;
+    }
+    if (levels != small)
+        free(levels);
+    c->depth = 0;
+    return ret;
+}
+
+/*
+ * The tree builder is a handler. Each open container has a lept_frame on
+ * the context stack, followed by the elements (lept_value) or members
+ * (lept_member) parsed so far. Frames are linked by stack offset because
+ * the stack may be reallocated by any push.
+ */
+typedef struct {
+    size_t parent;          /* stack offset of the enclosing frame, or LEPT_NO_FRAME */
+    size_t size;            /* number of elements/members pushed after this frame, or put in e */
+    void* e;                /* elements/members filled in place when the size is known, or NULL */
+    size_t capacity;        /* of e */
+    char* k;                /* object: key of the member being parsed */
+    size_t klen;
+    unsigned kflags;
+    lept_type type;         /* LEPT_ARRAY or LEPT_OBJECT */
+}lept_frame;
+
+#define LEPT_NO_FRAME ((size_t)-1)
+#define FRAME(c) ((lept_frame*)((c)->stack + (c)->frame))
+
+typedef struct {
+    lept_context* c;
+    lept_value* v;          /* receives the root value */
+}lept_tree;
+
+/* Hash index of an object's members, in slots of (position + 1, key hash). */
+typedef struct {
+    size_t count;   /* members m[0, count) are in the slots */
+    size_t mask;    /* number of slots - 1 */
+}lept_object_index;
+
+#define INDEX_SLOTS(x) ((uint32_t*)((lept_object_index*)(x) + 1))
+
+/*
+ * An object indexed by lept_index_object() (LEPT_FLAG_INDEXED) keeps the
+ * pointer to its index in front of its members, ahead of any CHILD_HEADER;
+ * other objects do not carry it.
+ */
+#define INDEX_HEADER            sizeof(lept_object_index*)
+#define OINDEX(m)               (((lept_object_index**)((char*)(m) - CHILD_HEADER))[-1])
+
+#define LEPT_CHILD_SIZE(type)   ((type) == LEPT_ARRAY ? sizeof(lept_value) : sizeof(lept_member))
+
+/* Sets up the header of a new block of children, returning its first child. */
+static void* lept_children_init(char* p, size_t capacity) {
+    p += CHILD_HEADER;
+#ifdef LEPT_COMPACT_VALUE
+    ((uint64_t*)p)[-1] = capacity;
+#else
+    (void)capacity; /* kept in the value itself */
+#endif
+    return p;
+}
+
+static void lept_children_free(void* e) {
+    if (e != NULL)
+        free((char*)e - CHILD_HEADER);
+}
+
+/* Resizes the heap block of an array's or object's children. */
+static void* lept_children_realloc(void* e, size_t capacity, lept_type type) {
+    char* p;
+#ifdef LEPT_COMPACT_VALUE
+    if (capacity == 0) {
+        lept_children_free(e);
+        return NULL;
+    }
+#endif
+    p = (char*)realloc(e != NULL ? (char*)e - CHILD_HEADER : NULL, CHILD_HEADER + capacity * LEPT_CHILD_SIZE(type));
+    return lept_children_init(p, capacity);
+}
+
+/* A block for the children of a container. */
+static void* lept_tree_alloc(lept_context* c, size_t capacity, lept_type type) {
+    size_t size = CHILD_HEADER + capacity * LEPT_CHILD_SIZE(type);
+    char* p = c->arena != NULL ? (char*)lept_arena_alloc(c->arena, size, sizeof(double)) : (char*)malloc(size);
+    return lept_children_init(p, capacity);
+}
+
+static void lept_push_frame(lept_context* c, lept_type type) {
+    lept_frame* f = (lept_frame*)lept_context_push(c, sizeof(lept_frame));
+    size_t n;
+    f->parent = c->frame;
+    f->size = 0;
+    f->e = NULL;
+    f->capacity = 0;
+    f->k = NULL;
+    f->type = type;
+    c->frame = (char*)f - c->stack;
+    if (c->sizes != NULL && c->isize < c->nsizes && (n = c->sizes[c->isize++]) > 0) {
+        f->e = lept_tree_alloc(c, n, type);
+        f->capacity = n;
+    }
+}
+
+/* Closes the innermost container, moving its children into v. */
+static void lept_pop_frame(lept_context* c, lept_value* v) {
+    lept_frame* f = FRAME(c);
+    size_t size = f->size, parent = f->parent, capacity = f->capacity, bytes = size * LEPT_CHILD_SIZE(f->type);
+    void* e = f->e;
+    if (e == NULL && size > 0) {
+        e = memcpy(lept_tree_alloc(c, size, f->type), lept_context_pop(c, bytes), bytes);
+        capacity = size;
+    }
+    v->type = f->type;
+    v->flags = c->arena != NULL ? LEPT_FLAG_BORROWED : 0;
+    if (f->type == LEPT_ARRAY) {
+        v->u.a.e = (lept_value*)e;
+        ASIZE(v) = size;
+        SET_ACAPACITY(v, capacity);
+    }
+    else {
+        v->u.o.m = (lept_member*)e;
+        OSIZE(v) = size;
+        SET_OCAPACITY(v, capacity);
+    }
+    lept_context_pop(c, sizeof(lept_frame));
+    c->frame = parent;
+}
+
+/* Drops the innermost container, freeing its children and pending key. */
+static void lept_discard_frame(lept_context* c) {
+    lept_frame* f = FRAME(c);
+    size_t i, size = f->size, parent = f->parent;
+    lept_type type = f->type;
+    void* e = f->e;
+    if (f->k != NULL && !(f->kflags & LEPT_FLAG_BORROWED))
+        free(f->k);
+    for (i = size; i-- > 0; ) {
+        if (type == LEPT_ARRAY)
+            lept_free(e != NULL ? (lept_value*)e + i : (lept_value*)lept_context_pop(c, sizeof(lept_value)));
+        else {
+            lept_member* m = e != NULL ? (lept_member*)e + i : (lept_member*)lept_context_pop(c, sizeof(lept_member));
+            if (!(m->kflags & LEPT_FLAG_BORROWED))
+                free(m->k);
+            lept_free(&m->v);
+        }
+    }
+    if (c->arena == NULL)
+        lept_children_free(e);
+    lept_context_pop(c, sizeof(lept_frame));
+    c->frame = parent;
+}
+
+/* Hands the complete value e to the innermost container, or makes it the root. */
+static int lept_tree_value(lept_tree* t, const lept_value* e) {
+    lept_context* c = t->c;
+    lept_frame* f;
+    if (c->frame == LEPT_NO_FRAME) {
+        memcpy(t->v, e, sizeof(lept_value));
+        return LEPT_PARSE_OK;
+    }
+    f = FRAME(c);
+    if (f->e != NULL) {
+        if (f->size == f->capacity)
+            return LEPT_PARSE_INVALID_VALUE; /* never with sizes counted on the same text */
+        if (f->type == LEPT_ARRAY)
+            memcpy((lept_value*)f->e + f->size, e, sizeof(lept_value));
+        else {
+            lept_member* m = (lept_member*)f->e + f->size;
+            m->k = f->k;
+            m->klen = f->klen;
+            m->kflags = f->kflags;
+            memcpy(&m->v, e, sizeof(lept_value));
+            f->k = NULL;
+        }
+        f->size++;
+        return LEPT_PARSE_OK;
+    }
+    if (f->type == LEPT_ARRAY)
+        memcpy(lept_context_push(c, sizeof(lept_value)), e, sizeof(lept_value));
+    else {
+        lept_member* m = (lept_member*)lept_context_push(c, sizeof(lept_member));
+        f = FRAME(c);
+        m->k = f->k;
+        m->klen = f->klen;
+        m->kflags = f->kflags;
+        memcpy(&m->v, e, sizeof(lept_value));
+        f->k = NULL; /* ownership is transferred to member on stack */
+    }
+    FRAME(c)->size++;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tree_null(void* ud) {
+    lept_value e;
+    lept_init(&e);
+    return lept_tree_value((lept_tree*)ud, &e);
+}
+
+static int lept_tree_boolean(void* ud, int b) {
+    lept_value e;
+    lept_init(&e);
+    e.type = b ? LEPT_TRUE : LEPT_FALSE;
+    return lept_tree_value((lept_tree*)ud, &e);
+}
+
+static int lept_tree_number(void* ud, double n) {
+    lept_value e;
+    e.u.n = n;
+    e.type = LEPT_NUMBER;
+    e.flags = 0;
+    return lept_tree_value((lept_tree*)ud, &e);
+}
+
+static int lept_tree_int64(void* ud, int64_t i) {
+    lept_value e;
+    e.u.i64 = i;
+    e.type = LEPT_NUMBER;
+    e.flags = LEPT_FLAG_INT64;
+    return lept_tree_value((lept_tree*)ud, &e);
+}
+
+static int lept_tree_uint64(void* ud, uint64_t u) {
+    lept_value e;
+    e.u.u64 = u;
+    e.type = LEPT_NUMBER;
+    e.flags = LEPT_FLAG_UINT64;
+    return lept_tree_value((lept_tree*)ud, &e);
+}
+
+static int lept_tree_string(void* ud, const char* s, size_t len) {
+    lept_context* c = ((lept_tree*)ud)->c;
+    lept_value e;
+    if (TOO_BIG(len))
+        return LEPT_PARSE_SIZE_TOO_BIG;
+    lept_init(&e);
+    if (c->insitu || (c->arena != NULL && len > LEPT_STRING_INLINE_MAX)) {
+        e.u.s.s = c->insitu ? (char*)s : lept_arena_string(c->arena, s, len);
+        SLEN(&e) = len;
+        e.type = LEPT_STRING;
+        e.flags = LEPT_FLAG_BORROWED;
+    }
+    else
+        lept_set_string(&e, s, len);
+    return lept_tree_value((lept_tree*)ud, &e);
+}
+
+static int lept_tree_start_object(void* ud) {
+    lept_push_frame(((lept_tree*)ud)->c, LEPT_OBJECT);
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tree_key(void* ud, const char* k, size_t klen) {
+    lept_context* c = ((lept_tree*)ud)->c;
+    lept_frame* f = FRAME(c);
+    if (TOO_BIG(klen))
+        return LEPT_PARSE_SIZE_TOO_BIG;
+    if (c->keys != NULL) {
+        f->k = lept_keys_intern(c->keys, k, klen);
+        f->kflags = LEPT_FLAG_BORROWED;
+    }
+    else if (c->insitu || c->arena != NULL) {
+        f->k = c->insitu ? (char*)k : lept_arena_string(c->arena, k, klen);
+        f->kflags = LEPT_FLAG_BORROWED;
+    }
+    else {
+        memcpy(f->k = (char*)malloc(klen + 1), k, klen);
+        f->k[klen] = '\0';
+        f->kflags = 0;
+    }
+    f->klen = klen;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tree_start_array(void* ud) {
+    lept_push_frame(((lept_tree*)ud)->c, LEPT_ARRAY);
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tree_end(void* ud) {
+    lept_value e;
+    if (TOO_BIG(FRAME(((lept_tree*)ud)->c)->size))
+        return LEPT_PARSE_SIZE_TOO_BIG; /* the frame is still whole, to be dropped */
+    lept_init(&e);
+    lept_pop_frame(((lept_tree*)ud)->c, &e);
+    return lept_tree_value((lept_tree*)ud, &e);
+}
+
+#define LEPT_SAME_KEY(a, b) ((a)->klen == (b)->klen && ((a)->k == (b)->k || memcmp((a)->k, (b)->k, (a)->klen) == 0))
+
+/*
+ * Applies c->duplicates to the members of the innermost object before it is
+ * closed. A repeated key is looked up among the members kept so far: by a
+ * scan in a small object, else in a hash table pushed on the context stack.
+ */
+static int lept_tree_duplicates(lept_context* c) {
+    lept_frame* f = FRAME(c);
+    size_t i, j = 0, n = f->size, kept = 0, slots = 0, bytes = 0, table = c->top;
+    uint32_t* t = NULL, h = 0;
+    lept_member* m;
+    int ret = LEPT_PARSE_OK;
+    if (n >= LEPT_OBJECT_INDEX_MIN) {
+        for (slots = 2 * LEPT_OBJECT_INDEX_MIN; slots < 2 * n; slots *= 2)
+            ;
+        bytes = slots * 2 * sizeof(uint32_t);
+        memset(lept_context_push(c, bytes), 0, bytes);
+        f = FRAME(c);
+        t = (uint32_t*)(c->stack + table);
+    }
+    m = f->e != NULL ? (lept_member*)f->e : (lept_member*)(f + 1);
+    for (i = 0; i < n; i++) {
+        lept_member* first = NULL;
+        if (t != NULL) {
+            h = lept_hash(m[i].k, m[i].klen);
+            for (j = h & (slots - 1); t[2 * j] != 0; j = (j + 1) & (slots - 1))
+                if (t[2 * j + 1] == h && LEPT_SAME_KEY(&m[t[2 * j] - 1], &m[i])) {
+                    first = &m[t[2 * j] - 1];
+                    break;
+                }
+        }
+        else
+            for (j = 0; j < kept; j++)
+                if (LEPT_SAME_KEY(&m[j], &m[i])) {
+                    first = &m[j];
+                    break;
+                }
+        if (first == NULL) {
+            if (t != NULL) {
+                t[2 * j] = (uint32_t)(kept + 1);
+                t[2 * j + 1] = h;
+            }
+            if (kept != i)
+                memcpy(&m[kept], &m[i], sizeof(lept_member));
+            kept++;
+            continue;
+        }
+        if (c->duplicates & LEPT_PARSE_FLAG_DUPLICATES_REJECT) {
+            ret = LEPT_PARSE_DUPLICATE_KEY; /* nothing dropped yet, so the frame is intact */
+            break;
+        }
+        if (c->duplicates & LEPT_PARSE_FLAG_DUPLICATES_LAST)
+            lept_move(&first->v, &m[i].v);
+        else
+            lept_free(&m[i].v);
+        if (!(m[i].kflags & LEPT_FLAG_BORROWED))
+            free(m[i].k);
+    }
+    c->top = table;
+    if (ret == LEPT_PARSE_OK) {
+        if (f->e == NULL)
+            lept_context_pop(c, (n - kept) * sizeof(lept_member));
+        f->size = kept;
+    }
+    return ret;
+}
+
+static int lept_tree_end_object(void* ud) {
+    lept_context* c = ((lept_tree*)ud)->c;
+    int ret;
+    if (c->duplicates && (ret = lept_tree_duplicates(c)) != LEPT_PARSE_OK)
+        return ret;
+    return lept_tree_end(ud);
+}
+
+static const lept_handler lept_tree_handler = {
+    lept_tree_null, lept_tree_boolean, lept_tree_number, lept_tree_int64, lept_tree_uint64, lept_tree_string,
+    lept_tree_start_object, lept_tree_key, lept_tree_end_object, lept_tree_start_array, lept_tree_end
+};
+
+static int lept_parse_value(lept_context* c, lept_value* v) {
+    lept_tree t;
+    int ret;
+    t.c = c;
+    t.v = v;
+    if ((ret = lept_parse_events(c, &lept_tree_handler, &t)) != LEPT_PARSE_OK) {
+        /* Pop and free every container still open */
+        while (c->frame != LEPT_NO_FRAME)
+            lept_discard_frame(c);
+    }
+    return ret;
+}
+
+/*
+ * Structural index (LEPT_PARSE_FLAG_INDEXED). Stage 1 classifies the input
+ * 64 bytes at a time into bitmaps and records, in order, the offset of every
+ * structural character `{}[]:,` outside strings, every quote that opens or
+ * closes a string, every escaping backslash and control character inside
+ * one, and the first byte of every other token (true, 12, ...). Stage 2
+ * tokenizes from the entries instead of scanning bytes: a string's raw runs
+ * end at its next entry, a literal runs up to the next entry less trailing
+ * whitespace, and a whitespace run is skipped by jumping to the next entry.
+ */
+#define LEPT_INDEX_BLOCK 64
+
+typedef struct {
+    uint64_t quote, backslash, ws, op, open, close;  /* op: any of {}[]:, open: { or [, close: } or ] */
+    uint64_t control;   /* bytes below 0x20 */
+}lept_block;
+
+#if defined(LEPT_AVX2)
+static void lept_classify(const char* p, lept_block* b) {
+    int i;
+    b->quote = b->backslash = b->ws = b->op = b->open = b->close = b->control = 0;
+    for (i = 0; i < LEPT_INDEX_BLOCK; i += 32) {
+        const __m256i s = _mm256_loadu_si256((const __m256i*)(p + i));
+        const __m256i t = _mm256_or_si256(s, _mm256_set1_epi8(0x20)); /* '[' -> '{', ']' -> '}' */
+        const __m256i open = _mm256_cmpeq_epi8(t, _mm256_set1_epi8('{')), close = _mm256_cmpeq_epi8(t, _mm256_set1_epi8('}'));
+        __m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(s, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(s, _mm256_set1_epi8('\n')));
+        __m256i op = _mm256_or_si256(_mm256_cmpeq_epi8(s, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(s, _mm256_set1_epi8(',')));
+        ws = _mm256_or_si256(ws, _mm256_or_si256(_mm256_cmpeq_epi8(s, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(s, _mm256_set1_epi8('\t'))));
+        op = _mm256_or_si256(op, _mm256_or_si256(open, close));
+        b->quote |= (uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, _mm256_set1_epi8('"'))) << i;
+        b->backslash |= (uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, _mm256_set1_epi8('\\'))) << i;
+        b->ws |= (uint64_t)(unsigned)_mm256_movemask_epi8(ws) << i;
+        b->op |= (uint64_t)(unsigned)_mm256_movemask_epi8(op) << i;
+        b->open |= (uint64_t)(unsigned)_mm256_movemask_epi8(open) << i;
+        b->close |= (uint64_t)(unsigned)_mm256_movemask_epi8(close) << i;
+        b->control |= (uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(s, _mm256_set1_epi8(0x1F)), s)) << i;
+    }
+}
+#elif defined(LEPT_SSE2)
+static void lept_classify(const char* p, lept_block* b) {
+    int i;
+    b->quote = b->backslash = b->ws = b->op = b->open = b->close = b->control = 0;
+    for (i = 0; i < LEPT_INDEX_BLOCK; i += 16) {
+        const __m128i s = _mm_loadu_si128((const __m128i*)(p + i));
+        const __m128i t = _mm_or_si128(s, _mm_set1_epi8(0x20)); /* '[' -> '{', ']' -> '}' */
+        const __m128i open = _mm_cmpeq_epi8(t, _mm_set1_epi8('{')), close = _mm_cmpeq_epi8(t, _mm_set1_epi8('}'));
+        __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(s, _mm_set1_epi8('\n')));
+        __m128i op = _mm_or_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8(':')), _mm_cmpeq_epi8(s, _mm_set1_epi8(',')));
+        ws = _mm_or_si128(ws, _mm_or_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(s, _mm_set1_epi8('\t'))));
+        op = _mm_or_si128(op, _mm_or_si128(open, close));
+        b->quote |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(s, _mm_set1_epi8('"'))) << i;
+        b->backslash |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(s, _mm_set1_epi8('\\'))) << i;
+        b->ws |= (uint64_t)(unsigned)_mm_movemask_epi8(ws) << i;
+        b->op |= (uint64_t)(unsigned)_mm_movemask_epi8(op) << i;
+        b->open |= (uint64_t)(unsigned)_mm_movemask_epi8(open) << i;
+        b->close |= (uint64_t)(unsigned)_mm_movemask_epi8(close) << i;
+        b->control |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(s, _mm_set1_epi8(0x1F)), s)) << i;
+    }
+}
+#else
+static void lept_classify(const char* p, lept_block* b) {
+    int i;
+    b->quote = b->backslash = b->ws = b->op = b->open = b->close = b->control = 0;
+    for (i = 0; i < LEPT_INDEX_BLOCK; i++) {
+        uint64_t bit = (uint64_t)1 << i;
+        if ((unsigned char)p[i] < 0x20)
+            b->control |= bit;
+        switch (p[i]) {
+            case '"':  b->quote |= bit; break;
+            case '\\': b->backslash |= bit; break;
+            case ' ': case '\t': case '\n': case '\r': b->ws |= bit; break;
+            case '{': case '[': b->open |= bit; b->op |= bit; break;
+            case '}': case ']': b->close |= bit; b->op |= bit; break;
+            case ':': case ',': b->op |= bit; break;
+        }
+    }
+}
+#endif
+
+static int lept_ctz64(uint64_t x) {
+    int n = 0;
+    assert(x != 0);
+#if defined(__GNUC__)
+    n = __builtin_ctzll(x);
+#else
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+#endif
+    return n;
+}
+
+/* Bit i of the result is the XOR of bits 0..i of x. */
+static uint64_t lept_prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/* Classifies the block at p, which may run past end; missing bytes read as whitespace. */
+static void lept_classify_at(const char* p, const char* end, lept_block* b) {
+    if (end - p >= LEPT_INDEX_BLOCK)
+        lept_classify(p, b);
+    else {
+        char tail[LEPT_INDEX_BLOCK];
+        memset(tail, ' ', sizeof(tail));
+        memcpy(tail, p, end - p);
+        lept_classify(tail, b);
+    }
+}
+
+/*
+ * Drops escaped quotes and backslashes from b->quote and b->backslash and
+ * returns the mask of bytes from an opening quote up to, but excluding, its
+ * closing quote. *escaped and
+ * *in_string carry the state from one block to the next and start at 0.
+ */
+static uint64_t lept_find_strings(lept_block* b, uint64_t* escaped, uint64_t* in_string) {
+    uint64_t bs, carry = 0, strings;
+    /* a backslash escapes the next byte unless it is itself escaped */
+    bs = b->backslash & ~*escaped;
+    while (bs != 0) {
+        uint64_t lowest = bs & (~bs + 1);
+        *escaped |= lowest << 1;
+        carry = lowest >> 63; /* the last byte escapes the first of the next block */
+        bs &= ~(lowest | lowest << 1);
+    }
+    b->quote &= ~*escaped;
+    b->backslash &= ~*escaped;
+    *escaped = carry;
+    strings = lept_prefix_xor(b->quote) ^ *in_string;
+    *in_string = (uint64_t)0 - (strings >> 63);
+    return strings;
+}
+
+/*
+ * Returns a malloc'd array of offsets terminated by len, or NULL for inputs
+ * too long to be indexed with 32-bit offsets.
+ */
+static uint32_t* lept_build_index(const char* json, size_t len) {
+    uint32_t* index;
+    size_t n = 0, capacity, i;
+    uint64_t escaped = 0, in_string = 0, other = 0; /* carried over from the previous block */
+    if (len >= (uint32_t)-1)
+        return NULL;
+    capacity = len / 8 + LEPT_INDEX_BLOCK + 1;
+    index = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    for (i = 0; i < len; i += LEPT_INDEX_BLOCK) {
+        lept_block b;
+        uint64_t strings, tokens, s;
+        lept_classify_at(json + i, json + len, &b);
+        strings = lept_find_strings(&b, &escaped, &in_string);
+        /* runs of literal and number characters; only their first bytes are indexed */
+        tokens = ~(b.quote | b.ws | b.op) & ~strings;
+        s = (b.op & ~strings) | b.quote | ((b.backslash | b.control) & strings) | (tokens & ~(tokens << 1 | other));
+        other = tokens >> 63;
+        if (n + LEPT_INDEX_BLOCK + 1 > capacity) {
+            while (n + LEPT_INDEX_BLOCK + 1 > capacity)
+                capacity += capacity >> 1;
+            index = (uint32_t*)realloc(index, capacity * sizeof(uint32_t));
+        }
+        while (s != 0) {
+            index[n++] = (uint32_t)(i + lept_ctz64(s));
+            s &= s - 1;
+        }
+    }
+    index[n] = (uint32_t)len;
+    return index;
+}
+
+/*
+ * The element or member count of every container, in the order they open:
+ * one for a child right after the bracket, plus one per comma directly
+ * inside. A text that parses has exactly these counts, so each container
+ * can be allocated once at its size and filled in place.
+ */
+static uint32_t* lept_count_sizes(const char* json, size_t len, const uint32_t* index, size_t* nsizes) {
+    size_t entries, n = 0, depth = 0, k;
+    uint32_t* sizes, *open;
+    for (entries = 0; index[entries] < len; entries++)
+        ;
+    sizes = (uint32_t*)malloc((entries * 2 + 1) * sizeof(uint32_t));
+    open = sizes + entries + 1; /* stack of open containers */
+    for (k = 0; k < entries; k++) {
+        switch (json[index[k]]) {
+            case '[':
+            case '{':
+                open[depth++] = (uint32_t)n;
+                sizes[n++] = index[k + 1] < len && json[index[k + 1]] != ']' && json[index[k + 1]] != '}';
+                break;
+            case ']':
+            case '}':
+                if (depth > 0)
+                    depth--;
+                break;
+            case ',':
+                if (depth > 0)
+                    sizes[open[depth - 1]]++;
+                break;
+        }
+    }
+    *nsizes = n;
+    return sizes;
+}
+
+/* Indexes the input of c, if it can, for LEPT_PARSE_FLAG_INDEXED. */
+static void lept_index_context(lept_context* c) {
+    size_t len = c->end - c->begin;
+    uint32_t* index = lept_build_index(c->begin, len);
+    if (index != NULL) {
+        c->index = index;
+        c->sizes = lept_count_sizes(c->begin, len, index, &c->nsizes);
+    }
+}
+
+static void lept_unindex_context(lept_context* c) {
+    free((void*)c->index);
+    free((void*)c->sizes);
+    c->index = c->sizes = NULL;
+}
+
+/*
+ * Returns the byte after the array or object starting at p, or NULL if it is
+ * not closed before end. Only brackets and strings are looked at, so the
+ * contents are not validated.
+ */
+#ifdef LEPT_SIMD_BLOCK
+static const char* lept_skip_container(const char* p, const char* end) {
+    uint64_t escaped = 0, in_string = 0;
+    size_t depth = 0;
+    for (; p < end; p += LEPT_INDEX_BLOCK) {
+        lept_block b;
+        uint64_t strings, brackets;
+        lept_classify_at(p, end, &b);
+        strings = lept_find_strings(&b, &escaped, &in_string);
+        brackets = (b.open | b.close) & ~strings;
+        for (; brackets != 0; brackets &= brackets - 1) {
+            if (b.open & brackets & (~brackets + 1))
+                depth++;
+            else if (--depth == 0)
+                return p + lept_ctz64(brackets) + 1;
+        }
+    }
+    return NULL;
+}
+#else
+static const char* lept_skip_container(const char* p, const char* end) {
+    size_t depth = 0;
+    for (; p < end; p++) {
+        switch (*p) {
+            case '[':
+            case '{':
+                depth++;
+                break;
+            case ']':
+            case '}':
+                if (--depth == 0)
+                    return p + 1;
+                break;
+            case '"':
+                for (p++; p < end && *p != '"'; p++)
+                    if (*p == '\\')
+                        p++;
+                if (p >= end)
+                    return NULL;
+                break;
+        }
+    }
+    return NULL;
+}
+#endif
+
+/* Parses the whole input as one value, keeping c->stack for the caller. */
+static int lept_parse_document(lept_context* c, lept_value* v) {
+    int ret;
+    lept_init(v);
+    lept_parse_whitespace(c);
+    if ((ret = lept_parse_value(c, v)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(c);
+        if (c->json != c->end) {
+            lept_free(v);
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+        }
+    }
+    assert(c->top == 0);
+    return ret;
+}
+
+static int lept_parse_root(lept_context* c, lept_value* v) {
+    int ret = lept_parse_document(c, v);
+    free(c->stack);
+    return ret;
+}
+
+static void lept_context_init(lept_context* c, const char* json, size_t len, unsigned flags) {
+    c->json = json;
+    c->end = json + len;
+    c->padded = (flags & LEPT_PARSE_FLAG_PADDED) != 0;
+    c->stack = NULL;
+    c->size = c->top = 0;
+    c->insitu = 0;
+    c->arena = NULL;
+    c->keys = NULL;
+    c->utf8 = (flags & LEPT_PARSE_FLAG_VALIDATE_UTF8) != 0;
+    c->duplicates = flags & (LEPT_PARSE_FLAG_DUPLICATES_REJECT | LEPT_PARSE_FLAG_DUPLICATES_FIRST | LEPT_PARSE_FLAG_DUPLICATES_LAST);
+    c->frame = LEPT_NO_FRAME;
+    c->depth = 0;
+    c->max_depth = LEPT_PARSE_MAX_DEPTH;
+    c->index = NULL;
+    c->begin = json;
+    c->ipos = 0;
+    c->sizes = NULL;
+    c->nsizes = c->isize = 0;
+}
+
+int lept_parse(lept_value* v, const char* json) {
+    lept_context c;
+    assert(v != NULL && json != NULL);
+    lept_context_init(&c, json, strlen(json), 0);
+    return lept_parse_root(&c, v);
+}
+
+int lept_parse_n(lept_value* v, const char* json, size_t len) {
+    return lept_parse_ex(v, json, len, 0);
+}
+
+int lept_parse_ex(lept_value* v, const char* json, size_t len, unsigned flags) {
+    lept_context c;
+    int ret;
+    assert(v != NULL && (json != NULL || len == 0));
+    lept_context_init(&c, json, len, flags);
+    if (flags & LEPT_PARSE_FLAG_INDEXED)
+        lept_index_context(&c);
+    ret = lept_parse_root(&c, v);
+    lept_unindex_context(&c);
+    return ret;
+}
+
+int lept_parse_insitu(lept_value* v, char* json) {
+    lept_context c;
+    assert(v != NULL && json != NULL);
+    lept_context_init(&c, json, strlen(json), 0);
+    c.insitu = 1;
+    return lept_parse_root(&c, v);
+}
+
+int lept_parse_file(lept_value* v, const char* path, unsigned flags) {
+#ifdef LEPT_MMAP
+    struct stat st;
+    size_t len, page;
+    char* json;
+    int fd, ret;
+    assert(v != NULL && path != NULL);
+    lept_init(v);
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return LEPT_FILE_IO_ERROR;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return LEPT_FILE_IO_ERROR;
+    }
+    if ((len = (size_t)st.st_size) == 0) {
+        close(fd);
+        return lept_parse_ex(v, "", 0, flags);
+    }
+#ifdef MAP_POPULATE
+    json = (char*)mmap(NULL, len, PROT_READ, MAP_PRIVATE | (flags & LEPT_PARSE_FLAG_POPULATE ? MAP_POPULATE : 0), fd, 0);
+#else
+    json = (char*)mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+#endif
+    close(fd);
+    if (json == (char*)MAP_FAILED)
+        return LEPT_FILE_IO_ERROR;
+    madvise(json, len, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    if (flags & LEPT_PARSE_FLAG_HUGEPAGES)
+        madvise(json, len, MADV_HUGEPAGE);
+#endif
+    /* the rest of the last page reads as zeros: when it is long enough, SIMD may over-read into it */
+    page = (size_t)sysconf(_SC_PAGESIZE);
+    flags &= ~LEPT_PARSE_FLAG_PADDED;
+    if (len % page != 0 && page - len % page >= LEPT_PARSE_PADDING)
+        flags |= LEPT_PARSE_FLAG_PADDED;
+    ret = lept_parse_ex(v, json, len, flags);
+    munmap(json, len);
+    return ret;
+#else
+    FILE* f;
+    char* json;
+    long len;
+    int ret;
+    assert(v != NULL && path != NULL);
+    lept_init(v);
+    if ((f = fopen(path, "rb")) == NULL)
+        return LEPT_FILE_IO_ERROR;
+    if (fseek(f, 0, SEEK_END) != 0 || (len = ftell(f)) < 0 || fseek(f, 0, SEEK_SET) != 0
+        || (json = (char*)malloc((size_t)len + 1)) == NULL) {
+        fclose(f);
+        return LEPT_FILE_IO_ERROR;
+    }
+    if (fread(json, 1, (size_t)len, f) != (size_t)len)
+        ret = LEPT_FILE_IO_ERROR;
+    else
+        ret = lept_parse_ex(v, json, (size_t)len, flags & ~LEPT_PARSE_FLAG_PADDED);
+    free(json);
+    fclose(f);
+    return ret;
+#endif
+}
+
+/*
+ * Validation walks the grammar like lept_parse_events() but decodes nothing
+ * and does not allocate: strings are only checked, and the kind of each open
+ * container is a bit, set for an object, in an array sized for
+ * LEPT_PARSE_MAX_DEPTH.
+ */
+static int lept_validate_string(lept_context* c) {
+    const char* p = c->json + 1;
+    unsigned u;
+    char ch;
+    for (;;) {
+        if ((p = lept_scan_string(c, p)) == c->end)
+            return LEPT_PARSE_MISS_QUOTATION_MARK;
+        switch (*p++) {
+            case '\"':
+                c->json = p;
+                return LEPT_PARSE_OK;
+            case '\\':
+                ch = AT(c, p);
+                p++;
+                switch (ch) {
+                    case '\"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                        break;
+                    case 'u':
+                        if (!(p = lept_parse_hex4(p, c->end, &u)))
+                            return LEPT_PARSE_INVALID_UNICODE_HEX;
+                        if (u >= 0xD800 && u <= 0xDBFF) {
+                            if (AT(c, p) != '\\' || AT(c, p + 1) != 'u')
+                                return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                            if (!(p = lept_parse_hex4(p + 2, c->end, &u)))
+                                return LEPT_PARSE_INVALID_UNICODE_HEX;
+                            if (u < 0xDC00 || u > 0xDFFF)
+                                return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                        }
+                        break;
+                    default:
+                        return LEPT_PARSE_INVALID_STRING_ESCAPE;
+                }
+                break;
+            default:
+                return LEPT_PARSE_INVALID_STRING_CHAR;
+        }
+    }
+}
+
+static int lept_validate_scalar(lept_context* c) {
+    lept_value e;
+    switch (PEEK(c)) {
+        case 't':  return lept_parse_literal(c, &e, "true", LEPT_TRUE);
+        case 'f':  return lept_parse_literal(c, &e, "false", LEPT_FALSE);
+        case 'n':  return lept_parse_literal(c, &e, "null", LEPT_NULL);
+        case '"':  return lept_validate_string(c);
+        case '\0': return LEPT_PARSE_EXPECT_VALUE;
+        default:   return lept_parse_number(c, &e);
+    }
+}
+
+static int lept_validate_key(lept_context* c) {
+    int ret;
+    if (PEEK(c) != '"')
+        return LEPT_PARSE_MISS_KEY;
+    if ((ret = lept_validate_string(c)) != LEPT_PARSE_OK)
+        return ret;
+    lept_parse_whitespace(c);
+    if (PEEK(c) != ':')
+        return LEPT_PARSE_MISS_COLON;
+    c->json++;
+    lept_parse_whitespace(c);
+    return LEPT_PARSE_OK;
+}
+
+#define LEPT_LEVEL_IS_OBJECT(levels, i) ((levels)[(i) / 8] >> (i) % 8 & 1)
+
+static int lept_validate_value(lept_context* c) {
+    unsigned char levels[LEPT_PARSE_MAX_DEPTH / 8 + 1];
+    size_t depth = 0;
+    int ret;
+    assert(c->max_depth <= LEPT_PARSE_MAX_DEPTH);
+    for (;;) {
+        char ch = PEEK(c);
+        if (ch == '[' || ch == '{') {
+            if (depth == c->max_depth)
+                return LEPT_PARSE_DEPTH_EXCEEDED;
+            if (ch == '{')
+                levels[depth / 8] |= (unsigned char)(1 << depth % 8);
+            else
+                levels[depth / 8] &= (unsigned char)~(1 << depth % 8);
+            depth++;
+            c->json++;
+            lept_parse_whitespace(c);
+            if (PEEK(c) != (ch == '[' ? ']' : '}')) {
+                if (ch == '{' && (ret = lept_validate_key(c)) != LEPT_PARSE_OK)
+                    return ret;
+                continue;
+            }
+            c->json++;
+            depth--;
+        }
+        else if ((ret = lept_validate_scalar(c)) != LEPT_PARSE_OK)
+            return ret;
+        /* a value is complete: close every container that ends here */
+        while (depth > 0) {
+            int object = LEPT_LEVEL_IS_OBJECT(levels, depth - 1);
+            lept_parse_whitespace(c);
+            if (PEEK(c) == ',') {
+                c->json++;
+                lept_parse_whitespace(c);
+                if (object && (ret = lept_validate_key(c)) != LEPT_PARSE_OK)
+                    return ret;
+                break;
+            }
+            else if (PEEK(c) == (object ? '}' : ']')) {
+                c->json++;
+                depth--;
+            }
+            else
+                return object ? LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET : LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+        }
+        if (depth == 0)
+            return LEPT_PARSE_OK;
+    }
+}
+
+int lept_validate(const char* json, size_t len, size_t* err_offset) {
+    lept_context c;
+    int ret;
+    assert(json != NULL || len == 0);
+    lept_context_init(&c, json, len, 0);
+    lept_parse_whitespace(&c);
+    if ((ret = lept_validate_value(&c)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (c.json != c.end)
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    if (ret != LEPT_PARSE_OK && err_offset != NULL)
+        *err_offset = c.json - json;
+    free(c.stack);
+    return ret;
+}
+
+int lept_parse_sax(const lept_handler* h, void* ctx, const char* json) {
+    lept_context c;
+    int ret;
+    assert(h != NULL && json != NULL);
+    lept_context_init(&c, json, strlen(json), 0);
+    lept_parse_whitespace(&c);
+    if ((ret = lept_parse_events(&c, h, ctx)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (c.json != c.end)
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    free(c.stack);
+    return ret;
+}
+
+/*
+ * Push parsing. lept_parser_run() walks the grammar one token at a time,
+ * driving the tree handler like lept_parse_events() does, and stops in front
+ * of a token that may go on in the next chunk. Such a token is copied to
+ * p->partial until its end arrives and then parsed from there, so only a
+ * split token is ever buffered and the usual parse routines, errors
+ * included, see whole tokens.
+ */
+enum {
+    LEPT_PUSH_VALUE,
+    LEPT_PUSH_FIRST_ELEMENT,    /* a value or ']' */
+    LEPT_PUSH_FIRST_KEY,        /* a key or '}' */
+    LEPT_PUSH_KEY,
+    LEPT_PUSH_COLON,
+    LEPT_PUSH_NEXT,             /* ',' or the closing bracket */
+    LEPT_PUSH_DONE              /* only whitespace may follow the root */
+};
+
+struct lept_parser {
+    lept_context c;             /* holds the frames of the tree being built */
+    lept_tree t;
+    lept_value v;               /* the root, once complete */
+    lept_buffer levels;         /* '[' or '{' for each open container */
+    lept_buffer partial;        /* a token split across chunks */
+    int escaped;                /* partial is a string ending in an unpaired backslash */
+    int state;
+    int ret;                    /* the first error, returned from then on */
+    size_t keep;                /* stack capacity kept between texts */
+};
+
+/* Bytes that may continue a literal or number; a split one is complete once another byte follows. */
+#define LEPT_PUSH_TOKEN(ch) (!ISWS(ch) && (ch) != ',' && (ch) != ']' && (ch) != '}' && (ch) != ':')
+
+/* Frees whatever was built and makes ret the result. */
+static void lept_parser_fail(lept_parser* p, int ret) {
+    while (p->c.frame != LEPT_NO_FRAME)
+        lept_discard_frame(&p->c);
+    if (p->state == LEPT_PUSH_DONE)
+        lept_free(&p->v);
+    p->ret = ret;
+}
+
+/* Whether the string token starting at p has no closing quote before end. */
+static int lept_parser_unterminated(const char* p, const char* end) {
+    for (p++; p < end && *p != '"'; p++)
+        if (*p == '\\')
+            p++;
+    return p >= end;
+}
+
+static int lept_parser_close(lept_parser* p) {
+    p->c.json++;
+    p->state = --p->levels.top == 0 ? LEPT_PUSH_DONE : LEPT_PUSH_NEXT;
+    return lept_tree_end(&p->t);
+}
+
+/*
+ * Parses json[0, len) on from p->state and returns how much was consumed:
+ * all of it, unless more input may follow and the last token reaches the end.
+ */
+static size_t lept_parser_run(lept_parser* p, const char* json, size_t len, int more) {
+    lept_context* c = &p->c;
+    const char* start;
+    char* str;
+    size_t slen;
+    int ret = LEPT_PARSE_OK;
+    c->json = json;
+    c->end = json + len;
+    while (ret == LEPT_PARSE_OK) {
+        char ch, top;
+        lept_parse_whitespace(c);
+        if (c->json == c->end)
+            return len;
+        ch = *(start = c->json);
+        switch (p->state) {
+            case LEPT_PUSH_FIRST_ELEMENT:
+                if (ch == ']') {
+                    ret = lept_parser_close(p);
+                    break;
+                }
+                p->state = LEPT_PUSH_VALUE;
+                continue;
+            case LEPT_PUSH_FIRST_KEY:
+                if (ch == '}') {
+                    ret = lept_parser_close(p);
+                    break;
+                }
+                /* fall through */
+            case LEPT_PUSH_KEY:
+                if (ch != '"') {
+                    ret = LEPT_PARSE_MISS_KEY;
+                    break;
+                }
+                if ((ret = lept_parse_string_raw(c, &str, &slen)) != LEPT_PARSE_OK) {
+                    if (more && lept_parser_unterminated(start, c->end))
+                        return start - json;
+                    break;
+                }
+                ret = lept_tree_key(&p->t, str, slen);
+                p->state = LEPT_PUSH_COLON;
+                break;
+            case LEPT_PUSH_COLON:
+                if (ch != ':') {
+                    ret = LEPT_PARSE_MISS_COLON;
+                    break;
+                }
+                c->json++;
+                p->state = LEPT_PUSH_VALUE;
+                break;
+            case LEPT_PUSH_VALUE:
+                if (ch == '[' || ch == '{') {
+                    if (p->levels.top == c->max_depth) {
+                        ret = LEPT_PARSE_DEPTH_EXCEEDED;
+                        break;
+                    }
+                    *(char*)lept_buffer_push(&p->levels, 1) = ch;
+                    c->json++;
+                    p->state = ch == '[' ? LEPT_PUSH_FIRST_ELEMENT : LEPT_PUSH_FIRST_KEY;
+                    ret = ch == '[' ? lept_tree_start_array(&p->t) : lept_tree_start_object(&p->t);
+                    break;
+                }
+                if (more && ch != '"') {
+                    const char* q = start;
+                    while (q < c->end && LEPT_PUSH_TOKEN(*q))
+                        q++;
+                    if (q == c->end)
+                        return start - json;
+                }
+                if ((ret = lept_parse_event_scalar(c, &lept_tree_handler, &p->t)) != LEPT_PARSE_OK) {
+                    if (more && ch == '"' && lept_parser_unterminated(start, c->end))
+                        return start - json;
+                    break;
+                }
+                p->state = p->levels.top == 0 ? LEPT_PUSH_DONE : LEPT_PUSH_NEXT;
+                break;
+            case LEPT_PUSH_NEXT:
+                top = p->levels.p[p->levels.top - 1];
+                if (ch == ',') {
+                    c->json++;
+                    p->state = top == '[' ? LEPT_PUSH_VALUE : LEPT_PUSH_KEY;
+                }
+                else if (ch == (top == '[' ? ']' : '}'))
+                    ret = lept_parser_close(p);
+                else
+                    ret = top == '[' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+                break;
+            default:
+                ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+        }
+    }
+    lept_parser_fail(p, ret);
+    return len;
+}
+
+/* Returns how many bytes of s continue the token in p->partial, setting *complete if they end it. */
+static size_t lept_parser_token_end(lept_parser* p, const char* s, size_t len, int* complete) {
+    size_t i;
+    if (p->partial.p[0] != '"') {
+        for (i = 0; i < len && LEPT_PUSH_TOKEN(s[i]); i++)
+            ;
+        *complete = i < len;
+        return i;
+    }
+    for (i = 0; i < len; i++) {
+        if (p->escaped)
+            p->escaped = 0;
+        else if (s[i] == '\\')
+            p->escaped = 1;
+        else if (s[i] == '"') {
+            *complete = 1;
+            return i + 1;
+        }
+    }
+    *complete = 0;
+    return len;
+}
+
+static void lept_parser_keep(lept_parser* p, const char* s, size_t len) {
+    if (len > 0)
+        memcpy(lept_buffer_push(&p->partial, len), s, len);
+}
+
+lept_parser* lept_parser_create(void) {
+    lept_parser* p = (lept_parser*)malloc(sizeof(lept_parser));
+    lept_context_init(&p->c, "", 0, 0);
+    p->t.c = &p->c;
+    p->t.v = &p->v;
+    lept_init(&p->v);
+    memset(&p->levels, 0, sizeof(lept_buffer));
+    memset(&p->partial, 0, sizeof(lept_buffer));
+    p->escaped = 0;
+    p->state = LEPT_PUSH_VALUE;
+    p->ret = LEPT_PARSE_OK;
+    p->keep = LEPT_PARSE_STACK_KEEP_SIZE;
+    return p;
+}
+
+void lept_parser_set_keep_size(lept_parser* p, size_t size) {
+    assert(p != NULL);
+    p->keep = size;
+}
+
+void lept_parser_free(lept_parser* p) {
+    assert(p != NULL);
+    lept_parser_fail(p, LEPT_PARSE_OK);
+    free(p->c.stack);
+    free(p->levels.p);
+    free(p->partial.p);
+    free(p);
+}
+
+int lept_parser_feed(lept_parser* p, const char* chunk, size_t len) {
+    size_t n;
+    int complete;
+    assert(p != NULL && (chunk != NULL || len == 0));
+    if (p->ret != LEPT_PARSE_OK || len == 0)
+        return p->ret;
+    if (p->partial.top > 0) {
+        n = lept_parser_token_end(p, chunk, len, &complete);
+        lept_parser_keep(p, chunk, n);
+        if (!complete)
+            return LEPT_PARSE_OK;
+        lept_parser_run(p, p->partial.p, p->partial.top, 0);
+        p->partial.top = 0;
+        chunk += n;
+        len -= n;
+    }
+    if (p->ret == LEPT_PARSE_OK && (n = lept_parser_run(p, chunk, len, 1)) < len) {
+        p->escaped = 0;
+        lept_parser_keep(p, chunk + n, 1);
+        lept_parser_token_end(p, chunk + n + 1, len - n - 1, &complete);
+        lept_parser_keep(p, chunk + n + 1, len - n - 1);
+    }
+    return p->ret;
+}
+
+int lept_parser_finish(lept_parser* p, lept_value* v) {
+    int ret;
+    assert(p != NULL && v != NULL);
+    if (p->ret == LEPT_PARSE_OK && p->partial.top > 0)
+        lept_parser_run(p, p->partial.p, p->partial.top, 0);
+    if (p->ret == LEPT_PARSE_OK) {
+        /* the error lept_parse_n() gives when the input ends here */
+        switch (p->state) {
+            case LEPT_PUSH_DONE:
+                break;
+            case LEPT_PUSH_VALUE:
+            case LEPT_PUSH_FIRST_ELEMENT:
+                lept_parser_fail(p, LEPT_PARSE_EXPECT_VALUE);
+                break;
+            case LEPT_PUSH_FIRST_KEY:
+            case LEPT_PUSH_KEY:
+                lept_parser_fail(p, LEPT_PARSE_MISS_KEY);
+                break;
+            case LEPT_PUSH_COLON:
+                lept_parser_fail(p, LEPT_PARSE_MISS_COLON);
+                break;
+            default:
+                lept_parser_fail(p, p->levels.p[p->levels.top - 1] == '[' ?
+                    LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET);
+        }
+    }
+    lept_init(v);
+    if ((ret = p->ret) == LEPT_PARSE_OK)
+        memcpy(v, &p->v, sizeof(lept_value));
+    /* ready for the next text, keeping the buffers */
+    assert(p->c.top == 0 && p->c.frame == LEPT_NO_FRAME);
+    lept_init(&p->v);
+    p->levels.top = p->partial.top = 0;
+    p->state = LEPT_PUSH_VALUE;
+    p->ret = LEPT_PARSE_OK;
+    lept_stack_trim(&p->c.stack, &p->c.size, p->keep);
+    return ret;
+}
+
+int lept_parser_parse(lept_parser* p, lept_value* v, const char* json, size_t len, unsigned flags) {
+    char* stack;
+    size_t size;
+    int ret;
+    assert(p != NULL && v != NULL && (json != NULL || len == 0));
+    assert(p->state == LEPT_PUSH_VALUE && p->partial.top == 0); /* not within a pushed text */
+    stack = p->c.stack;
+    size = p->c.size;
+    lept_context_init(&p->c, json, len, flags);
+    p->c.stack = stack;
+    p->c.size = size;
+    if (flags & LEPT_PARSE_FLAG_INDEXED)
+        lept_index_context(&p->c);
+    ret = lept_parse_document(&p->c, v);
+    lept_unindex_context(&p->c);
+    stack = p->c.stack;
+    size = p->c.size;
+    lept_context_init(&p->c, "", 0, 0);
+    p->c.stack = stack;
+    p->c.size = size;
+    lept_stack_trim(&p->c.stack, &p->c.size, p->keep);
+    return ret;
+}
+
+/*
+ * Documents. The tree of a parse is allocated from the document's arena:
+ * every container and string is borrowed, so nothing in it is freed on its
+ * own. Values set in the tree afterwards are heap-owned as usual; teardown
+ * walks the tree to free those, with no free() call for arena memory, then
+ * drops the arena blocks. The walk visits every node; a caller that has only
+ * read the tree skips it with lept_document_reset_unchanged().
+ */
+struct lept_document {
+    lept_value root;
+    lept_arena arena;
+    lept_keys keys;     /* LEPT_PARSE_FLAG_INTERN_KEYS, kept across parses */
+    char* stack;        /* parse stack, kept from one parse to the next */
+    size_t size;
+};
+
+lept_document* lept_document_create(void) {
+    lept_document* d = (lept_document*)malloc(sizeof(lept_document));
+    lept_init(&d->root);
+    memset(&d->arena, 0, sizeof(lept_arena));
+    memset(&d->keys, 0, sizeof(lept_keys));
+    d->stack = NULL;
+    d->size = 0;
+    return d;
+}
+
+void lept_document_reset(lept_document* d) {
+    assert(d != NULL);
+    lept_free(&d->root);
+    lept_arena_reset(&d->arena);
+    /* Keys are kept for the next text, unless too many to be a schema */
+    if (d->keys.count > LEPT_DOCUMENT_KEYS_KEEP)
+        lept_keys_clear(&d->keys);
+}
+
+void lept_document_reset_unchanged(lept_document* d) {
+    assert(d != NULL);
+    lept_init(&d->root);
+    lept_document_reset(d);
+}
+
+void lept_document_free(lept_document* d) {
+    assert(d != NULL);
+    lept_free(&d->root);
+    lept_arena_free(&d->arena);
+    lept_keys_free(&d->keys);
+    free(d->stack);
+    free(d);
+}
+
+int lept_document_parse(lept_document* d, const char* json, size_t len, unsigned flags) {
+    lept_context c;
+    int ret;
+    assert(d != NULL && (json != NULL || len == 0));
+    lept_document_reset(d);
+    lept_context_init(&c, json, len, flags);
+    c.stack = d->stack;
+    c.size = d->size;
+    c.arena = &d->arena;
+    if (flags & LEPT_PARSE_FLAG_INTERN_KEYS)
+        c.keys = &d->keys;
+    if (flags & LEPT_PARSE_FLAG_INDEXED)
+        lept_index_context(&c);
+    if ((ret = lept_parse_document(&c, &d->root)) != LEPT_PARSE_OK)
+        lept_arena_reset(&d->arena);
+    lept_unindex_context(&c);
+    d->stack = c.stack;
+    d->size = c.size;
+    lept_stack_trim(&d->stack, &d->size, LEPT_PARSE_STACK_KEEP_SIZE);
+    return ret;
+}
+
+const char* lept_document_find_key(const lept_document* d, const char* key, size_t klen) {
+    assert(d != NULL && key != NULL);
+    return lept_keys_find(&d->keys, key, klen);
+}
+
+lept_value* lept_document_root(lept_document* d) {
+    assert(d != NULL);
+    return &d->root;
+}
+
+/*
+ * Document streams. Each lept_stream_next() parses one root value where the
+ * previous one ended, with the context stack of the previous call.
+ */
+void lept_stream_init(lept_stream* s, const char* json, size_t len) {
+    assert(s != NULL && (json != NULL || len == 0));
+    s->json = json;
+    s->len = len;
+    s->pos = s->offset = 0;
+    s->stack = NULL;
+    s->size = 0;
+    s->ret = LEPT_PARSE_OK;
+}
+
+int lept_stream_next(lept_stream* s, lept_value* v) {
+    lept_context c;
+    assert(s != NULL && v != NULL);
+    lept_init(v);
+    if (s->ret != LEPT_PARSE_OK)
+        return s->ret;
+    lept_context_init(&c, s->json, s->len, 0);
+    c.json += s->pos;
+    c.stack = s->stack;
+    c.size = s->size;
+    lept_parse_whitespace(&c);
+    if (c.json == c.end)
+        return LEPT_STREAM_END;
+    s->offset = c.json - s->json;
+    s->ret = lept_parse_value(&c, v);
+    assert(c.top == 0);
+    s->pos = c.json - s->json;
+    s->stack = c.stack;
+    s->size = c.size;
+    return s->ret;
+}
+
+void lept_stream_free(lept_stream* s) {
+    assert(s != NULL);
+    free(s->stack);
+    s->stack = NULL;
+    s->size = 0;
+}
+
+/*
+ * JSON Lines. The buffer is cut into chunks of whole lines. With
+ * LEPT_THREADS, worker threads take the next chunk as they become free and
+ * parse it with their own context; the calling thread hands the results of
+ * chunk after chunk to the callback, in order. Workers stay at most
+ * LEPT_LINES_WINDOW chunks per thread ahead of it, which bounds the memory
+ * held by parsed but undelivered values.
+ */
+#ifndef LEPT_LINES_MIN_CHUNK
+#define LEPT_LINES_MIN_CHUNK 4096
+#endif
+
+#ifndef LEPT_LINES_WINDOW
+#define LEPT_LINES_WINDOW 4
+#endif
+
+typedef struct {
+    size_t offset;
+    int ret;
+    lept_value v;
+}lept_line;
+
+typedef struct {
+    size_t begin, end;
+    lept_buffer lines;      /* lept_line of every non-blank line */
+    int done;
+}lept_chunk;
+
+typedef struct {
+    const char* json;
+    lept_chunk* chunks;
+    size_t nchunks;
+    size_t next;            /* the first chunk no worker has taken */
+    size_t delivered;       /* the first chunk not yet given to the callback */
+    size_t window;
+    int stop;
+#ifdef LEPT_THREADS
+    pthread_mutex_t lock;
+    pthread_cond_t ready;   /* a chunk is done */
+    pthread_cond_t moved;   /* delivered moved on, or stop was set */
+#endif
+}lept_lines;
+
+static void lept_parse_chunk(const char* json, lept_chunk* k, lept_context* c) {
+    const char* p = json + k->begin, *end = json + k->end;
+    while (p < end) {
+        const char* eol = (const char*)memchr(p, '\n', end - p);
+        lept_line* line;
+        char* stack = c->stack;
+        size_t size = c->size;
+        if (eol == NULL)
+            eol = end;
+        lept_context_init(c, p, eol - p, 0);
+        c->stack = stack;
+        c->size = size;
+        lept_parse_whitespace(c);
+        if (c->json != c->end) {
+            line = (lept_line*)lept_buffer_push(&k->lines, sizeof(lept_line));
+            line->offset = c->json - json;
+            line->ret = lept_parse_document(c, &line->v);
+        }
+        p = eol + 1;
+    }
+}
+
+/* Hands the lines of k to f, then frees them; returns f's first non-zero result. */
+static int lept_deliver_chunk(lept_chunk* k, lept_line_callback f, void* ctx, int ret) {
+    lept_line* line = (lept_line*)k->lines.p;
+    size_t i, n = k->lines.top / sizeof(lept_line);
+    for (i = 0; i < n; i++) {
+        if (ret == 0)
+            ret = f(ctx, line[i].offset, line[i].ret, &line[i].v);
+        lept_free(&line[i].v);
+    }
+    free(k->lines.p);
+    memset(&k->lines, 0, sizeof(lept_buffer));
+    return ret;
+}
+
+/* Parses and delivers chunk after chunk in the calling thread. */
+static int lept_lines_serial(lept_lines* job, lept_line_callback f, void* ctx) {
+    lept_context c;
+    size_t i;
+    int ret = 0;
+    c.stack = NULL;
+    c.size = 0;
+    for (i = 0; i < job->nchunks && ret == 0; i++) {
+        lept_parse_chunk(job->json, &job->chunks[i], &c);
+        ret = lept_deliver_chunk(&job->chunks[i], f, ctx, ret);
+    }
+    free(c.stack);
+    return ret;
+}
+
+#ifdef LEPT_THREADS
+static void* lept_lines_worker(void* arg) {
+    lept_lines* job = (lept_lines*)arg;
+    lept_context c;
+    size_t i;
+    c.stack = NULL;
+    c.size = 0;
+    pthread_mutex_lock(&job->lock);
+    for (;;) {
+        while (!job->stop && job->next < job->nchunks && job->next >= job->delivered + job->window)
+            pthread_cond_wait(&job->moved, &job->lock);
+        if (job->stop || job->next == job->nchunks)
+            break;
+        i = job->next++;
+        pthread_mutex_unlock(&job->lock);
+        lept_parse_chunk(job->json, &job->chunks[i], &c);
+        pthread_mutex_lock(&job->lock);
+        job->chunks[i].done = 1;
+        pthread_cond_signal(&job->ready);
+    }
+    pthread_mutex_unlock(&job->lock);
+    free(c.stack);
+    return NULL;
+}
+
+static int lept_lines_run(lept_lines* job, unsigned threads, lept_line_callback f, void* ctx) {
+    pthread_t* workers = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    unsigned n;
+    size_t i;
+    int ret = 0;
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->ready, NULL);
+    pthread_cond_init(&job->moved, NULL);
+    job->window = (size_t)threads * LEPT_LINES_WINDOW;
+    for (n = 0; n < threads; n++)
+        if (pthread_create(&workers[n], NULL, lept_lines_worker, job) != 0)
+            break;
+    if (n == 0) {
+        free(workers);
+        return lept_lines_serial(job, f, ctx);
+    }
+    for (i = 0; i < job->nchunks && ret == 0; i++) {
+        pthread_mutex_lock(&job->lock);
+        while (!job->chunks[i].done)
+            pthread_cond_wait(&job->ready, &job->lock);
+        pthread_mutex_unlock(&job->lock);
+        ret = lept_deliver_chunk(&job->chunks[i], f, ctx, ret);
+        pthread_mutex_lock(&job->lock);
+        job->delivered = i + 1;
+        job->stop = ret != 0;
+        pthread_cond_broadcast(&job->moved);
+        pthread_mutex_unlock(&job->lock);
+    }
+    while (n > 0)
+        pthread_join(workers[--n], NULL);
+    /* after a stop, chunks parsed ahead are only freed */
+    for (; i < job->nchunks; i++)
+        lept_deliver_chunk(&job->chunks[i], f, ctx, 1);
+    pthread_cond_destroy(&job->moved);
+    pthread_cond_destroy(&job->ready);
+    pthread_mutex_destroy(&job->lock);
+    free(workers);
+    return ret;
+}
+#endif
+
+int lept_parse_lines(const char* json, size_t len, unsigned threads, lept_line_callback f, void* ctx) {
+    lept_lines job;
+    size_t chunk, i;
+    int ret;
+    assert((json != NULL || len == 0) && f != NULL);
+    chunk = len / ((size_t)(threads > 0 ? threads : 1) * 8);
+    if (chunk < LEPT_LINES_MIN_CHUNK)
+        chunk = LEPT_LINES_MIN_CHUNK;
+    job.json = json;
+    job.nchunks = len / chunk + 1;
+    job.chunks = (lept_chunk*)calloc(job.nchunks, sizeof(lept_chunk));
+    for (i = 0; i < job.nchunks; i++) {
+        lept_chunk* k = &job.chunks[i];
+        const char* eol;
+        k->begin = i == 0 ? 0 : k[-1].end;
+        k->end = len - k->begin > chunk ? k->begin + chunk : len;
+        /* extend to the end of the line */
+        if (k->end < len && (eol = (const char*)memchr(json + k->end, '\n', len - k->end)) != NULL)
+            k->end = eol - json + 1;
+        else
+            k->end = len;
+        if (k->end == len)
+            job.nchunks = i + 1;
+    }
+    job.next = job.delivered = 0;
+    job.stop = 0;
+#ifdef LEPT_THREADS
+    if (threads > 1)
+        ret = lept_lines_run(&job, threads < job.nchunks ? threads : (unsigned)job.nchunks, f, ctx);
+    else
+#endif
+        ret = lept_lines_serial(&job, f, ctx);
+    free(job.chunks);
+    return ret;
+}
+
+/*
+ * Tape words: a type tag in the top byte and a 56-bit payload.
+ * Containers: the open word holds the element/member count (saturated to
+ * 24 bits) above the index of its close word; the close word holds the
+ * index of its open word.
+ */
+#define LEPT_TAPE_WORD(tag, payload) (((uint64_t)(unsigned char)(tag) << 56) | (payload))
+#define LEPT_TAPE_TAG(w)            ((char)((w) >> 56))
+#define LEPT_TAPE_PAYLOAD(w)        ((w) & LEPT_U64(0x00FFFFFF, 0xFFFFFFFF))
+#define LEPT_TAPE_MAX_COUNT         0xFFFFFF
+
+typedef struct {
+    lept_buffer words, numbers, strings;
+}lept_tape_builder;
+
+static size_t lept_tape_put(lept_tape_builder* b, char tag, uint64_t payload) {
+    uint64_t w = LEPT_TAPE_WORD(tag, payload);
+    memcpy(lept_buffer_push(&b->words, sizeof(uint64_t)), &w, sizeof(uint64_t));
+    return b->words.top / sizeof(uint64_t) - 1;
+}
+
+static void lept_tape_put_string(lept_tape_builder* b, const char* s, size_t len) {
+    uint32_t n = (uint32_t)len;
+    char* p;
+    assert(len <= (uint32_t)-1);
+    lept_tape_put(b, '"', b->strings.top);
+    p = (char*)lept_buffer_push(&b->strings, sizeof(uint32_t) + len + 1);
+    memcpy(p, &n, sizeof(uint32_t));
+    if (len > 0)
+        memcpy(p + sizeof(uint32_t), s, len);
+    p[sizeof(uint32_t) + len] = '\0';
+}
+
+static void lept_tape_put_number(lept_tape_builder* b, const lept_value* v) {
+    lept_tape_put(b, (v->flags & LEPT_FLAG_INT64) ? 'l' : (v->flags & LEPT_FLAG_UINT64) ? 'u' : 'd', b->numbers.top / sizeof(uint64_t));
+    memcpy(lept_buffer_push(&b->numbers, sizeof(uint64_t)), &v->u, sizeof(uint64_t));
+}
+
+static void lept_tape_close(lept_tape_builder* b, size_t open, size_t count) {
+    uint64_t* words = (uint64_t*)b->words.p;
+    char tag = LEPT_TAPE_TAG(words[open]);
+    size_t close = lept_tape_put(b, tag == '[' ? ']' : '}', open);
+    assert(close <= 0xFFFFFFFF);
+    words = (uint64_t*)b->words.p;
+    if (count > LEPT_TAPE_MAX_COUNT)
+        count = LEPT_TAPE_MAX_COUNT;
+    words[open] = LEPT_TAPE_WORD(tag, (uint64_t)count << 32 | close);
+}
+
+/* Moves the three buffers into a single allocation. */
+static void lept_tape_finish(lept_tape_builder* b, lept_tape* t) {
+    t->nwords = b->words.top / sizeof(uint64_t);
+    t->words = (uint64_t*)malloc(b->words.top + b->numbers.top + b->strings.top);
+    t->numbers = t->words + t->nwords;
+    t->strings = (char*)(t->numbers + b->numbers.top / sizeof(uint64_t));
+    memcpy(t->words, b->words.p, b->words.top);
+    if (b->numbers.top > 0)
+        memcpy(t->numbers, b->numbers.p, b->numbers.top);
+    if (b->strings.top > 0)
+        memcpy(t->strings, b->strings.p, b->strings.top);
+    free(b->words.p);
+    free(b->numbers.p);
+    free(b->strings.p);
+}
+
+typedef struct {
+    size_t open, count;
+}lept_tape_frame;
+
+static int lept_parse_tape_key(lept_context* c, lept_tape_builder* b) {
+    char* str;
+    size_t len;
+    int ret;
+    if (PEEK(c) != '"')
+        return LEPT_PARSE_MISS_KEY;
+    if ((ret = lept_parse_string_raw(c, &str, &len)) != LEPT_PARSE_OK)
+        return ret;
+    lept_tape_put_string(b, str, len);
+    lept_parse_whitespace(c);
+    if (PEEK(c) != ':')
+        return LEPT_PARSE_MISS_COLON;
+    c->json++;
+    lept_parse_whitespace(c);
+    return LEPT_PARSE_OK;
+}
+
+/* The same iteration as lept_parse_value(), writing words instead of building values. */
+static int lept_parse_tape_value(lept_context* c, lept_tape_builder* b) {
+    lept_tape_frame* f;
+    lept_value e;
+    char* str;
+    size_t len;
+    int ret;
+    for (;;) {
+        char ch = PEEK(c);
+        if (ch == '[' || ch == '{') {
+            if (c->depth == c->max_depth) {
+                ret = LEPT_PARSE_DEPTH_EXCEEDED;
+                break;
+            }
+            f = (lept_tape_frame*)lept_context_push(c, sizeof(lept_tape_frame));
+            f->open = lept_tape_put(b, ch, 0);
+            f->count = 0;
+            c->depth++;
+            c->json++;
+            lept_parse_whitespace(c);
+            if (PEEK(c) != (ch == '[' ? ']' : '}')) {
+                if (ch == '{' && (ret = lept_parse_tape_key(c, b)) != LEPT_PARSE_OK)
+                    break;
+                continue;
+            }
+            c->json++;
+            lept_tape_close(b, f->open, 0);
+            lept_context_pop(c, sizeof(lept_tape_frame));
+            c->depth--;
+        }
+        else {
+            lept_init(&e);
+            switch (ch) {
+                case 't':  ret = lept_parse_literal(c, &e, "true", LEPT_TRUE); break;
+                case 'f':  ret = lept_parse_literal(c, &e, "false", LEPT_FALSE); break;
+                case 'n':  ret = lept_parse_literal(c, &e, "null", LEPT_NULL); break;
+                case '"':  ret = lept_parse_string_raw(c, &str, &len); break;
+                case '\0': ret = LEPT_PARSE_EXPECT_VALUE; break;
+                default:   ret = lept_parse_number(c, &e); break;
+            }
+            if (ret != LEPT_PARSE_OK)
+                break;
+            switch (ch) {
+                case 't':
+                case 'f':
+                case 'n':  lept_tape_put(b, ch, 0); break;
+                case '"':  lept_tape_put_string(b, str, len); break;
+                default:   lept_tape_put_number(b, &e); break;
+            }
+        }
+        /* a value is complete: count it, closing every container that ends here */
+        for (;;) {
+            char close;
+            if (c->depth == 0)
+                return LEPT_PARSE_OK;
+            f = (lept_tape_frame*)(c->stack + c->top - sizeof(lept_tape_frame));
+            f->count++;
+            close = LEPT_TAPE_TAG(((uint64_t*)b->words.p)[f->open]) == '[' ? ']' : '}';
+            lept_parse_whitespace(c);
+            if (PEEK(c) == ',') {
+                c->json++;
+                lept_parse_whitespace(c);
+                ret = close == '}' ? lept_parse_tape_key(c, b) : LEPT_PARSE_OK;
+                break;
+            }
+            else if (PEEK(c) == close) {
+                c->json++;
+                lept_tape_close(b, f->open, f->count);
+                lept_context_pop(c, sizeof(lept_tape_frame));
+                c->depth--;
+            }
+            else {
+                ret = close == ']' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+                break;
+            }
+        }
+        if (ret != LEPT_PARSE_OK)
+            break;
+    }
+    c->top = 0;
+    c->depth = 0;
+    return ret;
+}
+
+int lept_parse_tape(lept_tape* t, const char* json, size_t len) {
+    lept_context c;
+    lept_tape_builder b;
+    int ret;
+    assert(t != NULL && (json != NULL || len == 0));
+    memset(&b, 0, sizeof(b));
+    lept_context_init(&c, json, len, 0);
+    lept_parse_whitespace(&c);
+    if ((ret = lept_parse_tape_value(&c, &b)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (c.json != c.end)
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    free(c.stack);
+    if (ret == LEPT_PARSE_OK)
+        lept_tape_finish(&b, t);
+    else {
+        free(b.words.p);
+        free(b.numbers.p);
+        free(b.strings.p);
+        t->words = t->numbers = NULL;
+        t->strings = NULL;
+        t->nwords = 0;
+    }
+    return ret;
+}
+
+void lept_tape_free(lept_tape* t) {
+    assert(t != NULL);
+    free(t->words);
+    t->words = t->numbers = NULL;
+    t->strings = NULL;
+    t->nwords = 0;
+}
+
+lept_type lept_tape_get_type(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->nwords);
+    switch (LEPT_TAPE_TAG(t->words[i])) {
+        case 'n': return LEPT_NULL;
+        case 'f': return LEPT_FALSE;
+        case 't': return LEPT_TRUE;
+        case '"': return LEPT_STRING;
+        case '[': return LEPT_ARRAY;
+        case '{': return LEPT_OBJECT;
+        default:  assert(LEPT_TAPE_TAG(t->words[i]) != ']' && LEPT_TAPE_TAG(t->words[i]) != '}');
+                  return LEPT_NUMBER;
+    }
+}
+
+int lept_tape_get_boolean(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->nwords && (LEPT_TAPE_TAG(t->words[i]) == 't' || LEPT_TAPE_TAG(t->words[i]) == 'f'));
+    return LEPT_TAPE_TAG(t->words[i]) == 't';
+}
+
+double lept_tape_get_number(const lept_tape* t, size_t i) {
+    lept_value v;
+    assert(t != NULL && i < t->nwords && lept_tape_get_type(t, i) == LEPT_NUMBER);
+    memcpy(&v.u, &t->numbers[LEPT_TAPE_PAYLOAD(t->words[i])], sizeof(uint64_t));
+    switch (LEPT_TAPE_TAG(t->words[i])) {
+        case 'l': return (double)v.u.i64;
+        case 'u': return (double)v.u.u64;
+        default:  return v.u.n;
+    }
+}
+
+const char* lept_tape_get_string(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->nwords && LEPT_TAPE_TAG(t->words[i]) == '"');
+    return t->strings + LEPT_TAPE_PAYLOAD(t->words[i]) + sizeof(uint32_t);
+}
+
+size_t lept_tape_get_string_length(const lept_tape* t, size_t i) {
+    uint32_t n;
+    assert(t != NULL && i < t->nwords && LEPT_TAPE_TAG(t->words[i]) == '"');
+    memcpy(&n, t->strings + LEPT_TAPE_PAYLOAD(t->words[i]), sizeof(uint32_t));
+    return n;
+}
+
+size_t lept_tape_get_size(const lept_tape* t, size_t i) {
+    size_t size, e;
+    assert(t != NULL && i < t->nwords && (LEPT_TAPE_TAG(t->words[i]) == '[' || LEPT_TAPE_TAG(t->words[i]) == '{'));
+    if ((size = (size_t)(LEPT_TAPE_PAYLOAD(t->words[i]) >> 32)) < LEPT_TAPE_MAX_COUNT)
+        return size;
+    for (size = 0, e = lept_tape_first(t, i); e != lept_tape_end(t, i); size++)
+        e = lept_tape_next(t, LEPT_TAPE_TAG(t->words[i]) == '{' ? e + 1 : e);
+    return size;
+}
+
+size_t lept_tape_first(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->nwords && (LEPT_TAPE_TAG(t->words[i]) == '[' || LEPT_TAPE_TAG(t->words[i]) == '{'));
+    return i + 1;
+}
+
+size_t lept_tape_end(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->nwords && (LEPT_TAPE_TAG(t->words[i]) == '[' || LEPT_TAPE_TAG(t->words[i]) == '{'));
+    return (size_t)(t->words[i] & 0xFFFFFFFF);
+}
+
+size_t lept_tape_next(const lept_tape* t, size_t i) {
+    char tag;
+    assert(t != NULL && i < t->nwords);
+    tag = LEPT_TAPE_TAG(t->words[i]);
+    return tag == '[' || tag == '{' ? lept_tape_end(t, i) + 1 : i + 1;
+}
+
+size_t lept_tape_find_object_value(const lept_tape* t, size_t i, const char* key, size_t klen) {
+    size_t k;
+    assert(t != NULL && i < t->nwords && LEPT_TAPE_TAG(t->words[i]) == '{' && key != NULL);
+    for (k = lept_tape_first(t, i); k != lept_tape_end(t, i); k = lept_tape_next(t, k + 1))
+        if (lept_tape_get_string_length(t, k) == klen && memcmp(lept_tape_get_string(t, k), key, klen) == 0)
+            return k + 1;
+    return LEPT_KEY_NOT_EXIST;
+}
 
-typedef struct {
-    const char* json;
-    char* stack;
-    size_t size, top;
-}lept_context;
+void lept_tape_to_value(const lept_tape* t, size_t i, lept_value* v) {
+    size_t e;
+    assert(t != NULL && i < t->nwords && v != NULL);
+    lept_free(v);
+    switch (LEPT_TAPE_TAG(t->words[i])) {
+        case 'n': break;
+        case 'f': lept_set_boolean(v, 0); break;
+        case 't': lept_set_boolean(v, 1); break;
+        case 'd': lept_set_number(v, lept_tape_get_number(t, i)); break;
+        case 'l':
+        case 'u':
+            memcpy(&v->u, &t->numbers[LEPT_TAPE_PAYLOAD(t->words[i])], sizeof(uint64_t));
+            v->type = LEPT_NUMBER;
+            v->flags = LEPT_TAPE_TAG(t->words[i]) == 'l' ? LEPT_FLAG_INT64 : LEPT_FLAG_UINT64;
+            break;
+        case '"': lept_set_string(v, lept_tape_get_string(t, i), lept_tape_get_string_length(t, i)); break;
+        case '[':
+            lept_set_array(v, lept_tape_get_size(t, i));
+            for (e = lept_tape_first(t, i); e != lept_tape_end(t, i); e = lept_tape_next(t, e))
+                lept_tape_to_value(t, e, lept_pushback_array_element(v));
+            break;
+        case '{':
+            lept_set_object(v, lept_tape_get_size(t, i));
+            for (e = lept_tape_first(t, i); e != lept_tape_end(t, i); e = lept_tape_next(t, e + 1)) {
+                lept_member* m = &v->u.o.m[OSIZE(v)++];
+                size_t klen = lept_tape_get_string_length(t, e);
+                memcpy(m->k = (char*)malloc(klen + 1), lept_tape_get_string(t, e), klen + 1);
+                m->klen = klen;
+                m->kflags = 0;
+                lept_init(&m->v);
+                lept_tape_to_value(t, e + 1, &m->v);
+            }
+            break;
+        default: assert(0 && "invalid tape word");
+    }
+}
 
-static void* lept_context_push(lept_context* c, size_t size) {
-    void* ret;
-    assert(size > 0);
-    if (c->top + size >= c->size) {
-        if (c->size == 0)
-            c->size = LEPT_PARSE_STACK_INIT_SIZE;
-        while (c->top + size >= c->size)
-            c->size += c->size >> 1;  /* c->size * 1.5 */
-        c->stack = (char*)realloc(c->stack, c->size);
+static void lept_tape_put_value(lept_tape_builder* b, const lept_value* v) {
+    size_t i, open;
+    switch (v->type) {
+        case LEPT_NULL:   lept_tape_put(b, 'n', 0); break;
+        case LEPT_FALSE:  lept_tape_put(b, 'f', 0); break;
+        case LEPT_TRUE:   lept_tape_put(b, 't', 0); break;
+        case LEPT_NUMBER: lept_tape_put_number(b, v); break;
+        case LEPT_STRING: lept_tape_put_string(b, lept_get_string(v), lept_get_string_length(v)); break;
+        case LEPT_ARRAY:
+            open = lept_tape_put(b, '[', 0);
+            for (i = 0; i < ASIZE(v); i++)
+                lept_tape_put_value(b, &v->u.a.e[i]);
+            lept_tape_close(b, open, ASIZE(v));
+            break;
+        case LEPT_OBJECT:
+            open = lept_tape_put(b, '{', 0);
+            for (i = 0; i < OSIZE(v); i++) {
+                lept_tape_put_string(b, v->u.o.m[i].k, v->u.o.m[i].klen);
+                lept_tape_put_value(b, &v->u.o.m[i].v);
+            }
+            lept_tape_close(b, open, OSIZE(v));
+            break;
+        default: assert(0 && "invalid type");
     }
-    ret = c->stack + c->top;
-    c->top += size;
-    return ret;
 }
 
-static void* lept_context_pop(lept_context* c, size_t size) {
-    assert(c->top >= size);
-    return c->stack + (c->top -= size);
+void lept_tape_from_value(lept_tape* t, const lept_value* v) {
+    lept_tape_builder b;
+    assert(t != NULL && v != NULL);
+    memset(&b, 0, sizeof(b));
+    lept_tape_put_value(&b, v);
+    lept_tape_finish(&b, t);
 }
 
-static void lept_parse_whitespace(lept_context* c) {
-    const char *p = c->json;
-    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
-        p++;
-    c->json = p;
+/*
+ * On-demand access. A cursor is only a position in the document: nothing is
+ * decoded until a getter is called, and values stepped over on the way to a
+ * field or element are skipped by lept_skip_value() without being checked.
+ */
+static void lept_cursor_context(lept_context* c, const lept_cursor* cur) {
+    lept_context_init(c, cur->doc->json, cur->doc->len, 0);
+    c->json = cur->json;
 }
 
-static int lept_parse_literal(lept_context* c, lept_value* v, const char* literal, lept_type type) {
-    size_t i;
-    EXPECT(c, literal[0]);
-    for (i = 0; literal[i + 1]; i++)
-        if (c->json[i] != literal[i + 1])
-            return LEPT_PARSE_INVALID_VALUE;
-    c->json += i;
-    v->type = type;
-    return LEPT_PARSE_OK;
+static void lept_cursor_set(lept_cursor* cur, const lept_doc* doc, const char* json) {
+    cur->doc = doc;
+    cur->json = json;
+    cur->elem = NULL;
 }
 
-static int lept_parse_number(lept_context* c, lept_value* v) {
+static int lept_skip_value(lept_context* c) {
     const char* p = c->json;
-    if (*p == '-') p++;
-    if (*p == '0') p++;
-    else {
-        if (!ISDIGIT1TO9(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
-    }
-    if (*p == '.') {
-        p++;
-        if (!ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
-    }
-    if (*p == 'e' || *p == 'E') {
-        p++;
-        if (*p == '+' || *p == '-') p++;
-        if (!ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
+    switch (PEEK(c)) {
+        case '[':
+        case '{':
+            if ((p = lept_skip_container(p, c->end)) == NULL)
+                return *c->json == '[' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+            break;
+        case '"':
+            for (p++; ; ) {
+                if ((p = lept_scan_string(c, p)) == c->end)
+                    return LEPT_PARSE_MISS_QUOTATION_MARK;
+                if (*p == '"')
+                    break;
+                p += *p == '\\' && p + 1 < c->end ? 2 : 1;
+            }
+            p++;
+            break;
+        case '\0':
+            return LEPT_PARSE_EXPECT_VALUE;
+        default:
+            while (p < c->end && !ISWS(*p) && *p != ',' && *p != ']' && *p != '}' && *p != ':')
+                p++;
     }
-    errno = 0;
-    v->u.n = strtod(c->json, NULL);
-    if (errno == ERANGE && (v->u.n == HUGE_VAL || v->u.n == -HUGE_VAL))
-        return LEPT_PARSE_NUMBER_TOO_BIG;
-    v->type = LEPT_NUMBER;
     c->json = p;
     return LEPT_PARSE_OK;
 }
 
-static const char* lept_parse_hex4(const char* p, unsigned* u) {
-    int i;
-    *u = 0;
-    for (i = 0; i < 4; i++) {
-        char ch = *p++;
-        *u <<= 4;
-        if      (ch >= '0' && ch <= '9')  *u |= ch - '0';
-        else if (ch >= 'A' && ch <= 'F')  *u |= ch - ('A' - 10);
-        else if (ch >= 'a' && ch <= 'f')  *u |= ch - ('a' - 10);
-        else return NULL;
-    }
-    return p;
-}
-
-static void lept_encode_utf8(lept_context* c, unsigned u) {
-    if (u <= 0x7F) 
-        PUTC(c, u & 0xFF);
-    else if (u <= 0x7FF) {
-        PUTC(c, 0xC0 | ((u >> 6) & 0xFF));
-        PUTC(c, 0x80 | ( u       & 0x3F));
-    }
-    else if (u <= 0xFFFF) {
-        PUTC(c, 0xE0 | ((u >> 12) & 0xFF));
-        PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-        PUTC(c, 0x80 | ( u        & 0x3F));
-    }
-    else {
-        assert(u <= 0x10FFFF);
-        PUTC(c, 0xF0 | ((u >> 18) & 0xFF));
-        PUTC(c, 0x80 | ((u >> 12) & 0x3F));
-        PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-        PUTC(c, 0x80 | ( u        & 0x3F));
+/* The error lept_parse() would give if no value starts at c->json. */
+static int lept_expect_value(const lept_context* c) {
+    switch (PEEK(c)) {
+        case '\0': return LEPT_PARSE_EXPECT_VALUE;
+        case ',':
+        case ':':
+        case ']':
+        case '}':  return LEPT_PARSE_INVALID_VALUE;
+        default:   return LEPT_PARSE_OK;
     }
 }
 
-#define STRING_ERROR(ret) do { c->top = head; return ret; } while(0)
-
-static int lept_parse_string_raw(lept_context* c, char** str, size_t* len) {
-    size_t head = c->top;
-    unsigned u, u2;
-    const char* p;
-    EXPECT(c, '\"');
-    p = c->json;
-    for (;;) {
-        char ch = *p++;
-        switch (ch) {
-            case '\"':
-                *len = c->top - head;
-                *str = lept_context_pop(c, *len);
-                c->json = p;
-                return LEPT_PARSE_OK;
-            case '\\':
-                switch (*p++) {
-                    case '\"': PUTC(c, '\"'); break;
-                    case '\\': PUTC(c, '\\'); break;
-                    case '/':  PUTC(c, '/' ); break;
-                    case 'b':  PUTC(c, '\b'); break;
-                    case 'f':  PUTC(c, '\f'); break;
-                    case 'n':  PUTC(c, '\n'); break;
-                    case 'r':  PUTC(c, '\r'); break;
-                    case 't':  PUTC(c, '\t'); break;
-                    case 'u':
-                        if (!(p = lept_parse_hex4(p, &u)))
-                            STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
-                        if (u >= 0xD800 && u <= 0xDBFF) { /* surrogate pair */
-                            if (*p++ != '\\')
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-                            if (*p++ != 'u')
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-                            if (!(p = lept_parse_hex4(p, &u2)))
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
-                            if (u2 < 0xDC00 || u2 > 0xDFFF)
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-                            u = (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
-                        }
-                        lept_encode_utf8(c, u);
-                        break;
-                    default:
-                        STRING_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE);
-                }
-                break;
-            case '\0':
-                STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
-            default:
-                if ((unsigned char)ch < 0x20)
-                    STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
-                PUTC(c, ch);
-        }
-    }
+void lept_doc_init(lept_doc* d, const char* json, size_t len) {
+    assert(d != NULL && (json != NULL || len == 0));
+    d->json = json;
+    d->len = len;
 }
 
-static int lept_parse_string(lept_context* c, lept_value* v) {
+int lept_doc_root(const lept_doc* d, lept_cursor* root) {
+    lept_context c;
     int ret;
-    char* s;
-    size_t len;
-    if ((ret = lept_parse_string_raw(c, &s, &len)) == LEPT_PARSE_OK)
-        lept_set_string(v, s, len);
+    assert(d != NULL && root != NULL);
+    lept_context_init(&c, d->json, d->len, 0);
+    lept_parse_whitespace(&c);
+    if ((ret = lept_expect_value(&c)) == LEPT_PARSE_OK)
+        lept_cursor_set(root, d, c.json);
     return ret;
 }
 
-static int lept_parse_value(lept_context* c, lept_value* v);
+lept_type lept_cursor_get_type(const lept_cursor* cur) {
+    assert(cur != NULL && cur->json < cur->doc->json + cur->doc->len);
+    switch (*cur->json) {
+        case 'n': return LEPT_NULL;
+        case 'f': return LEPT_FALSE;
+        case 't': return LEPT_TRUE;
+        case '"': return LEPT_STRING;
+        case '[': return LEPT_ARRAY;
+        case '{': return LEPT_OBJECT;
+        default:  return LEPT_NUMBER;
+    }
+}
 
-static int lept_parse_array(lept_context* c, lept_value* v) {
-    size_t i, size = 0;
+int lept_cursor_find_field(const lept_cursor* obj, const char* key, size_t klen, lept_cursor* field) {
+    lept_context c;
     int ret;
-    EXPECT(c, '[');
-    lept_parse_whitespace(c);
-    if (*c->json == ']') {
-        c->json++;
-        lept_set_array(v, 0);
-        return LEPT_PARSE_OK;
-    }
+    assert(obj != NULL && field != NULL && (key != NULL || klen == 0) && lept_cursor_get_type(obj) == LEPT_OBJECT);
+    lept_cursor_context(&c, obj);
+    c.json++;
+    lept_parse_whitespace(&c);
+    if (PEEK(&c) == '}')
+        return LEPT_CURSOR_FIELD_NOT_FOUND;
     for (;;) {
-        lept_value e;
-        lept_init(&e);
-        if ((ret = lept_parse_value(c, &e)) != LEPT_PARSE_OK)
+        const char* q;
+        char* k;
+        size_t len;
+        int match;
+        if (PEEK(&c) != '"') {
+            ret = LEPT_PARSE_MISS_KEY;
             break;
-        memcpy(lept_context_push(c, sizeof(lept_value)), &e, sizeof(lept_value));
-        size++;
-        lept_parse_whitespace(c);
-        if (*c->json == ',') {
-            c->json++;
-            lept_parse_whitespace(c);
         }
-        else if (*c->json == ']') {
-            c->json++;
-            lept_set_array(v, size);
-            memcpy(v->u.a.e, lept_context_pop(c, size * sizeof(lept_value)), size * sizeof(lept_value));
-            v->u.a.size = size;
-            return LEPT_PARSE_OK;
+        /* compare keys without escapes in place, decode the others */
+        q = lept_scan_string(&c, c.json + 1);
+        if (q < c.end && *q == '"') {
+            match = (size_t)(q - c.json - 1) == klen && memcmp(c.json + 1, key, klen) == 0;
+            c.json = q + 1;
         }
         else {
-            ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
-            break;
+            if ((ret = lept_parse_string_raw(&c, &k, &len)) != LEPT_PARSE_OK)
+                break;
+            match = len == klen && memcmp(k, key, klen) == 0;
         }
-    }
-    /* Pop and free values on the stack */
-    for (i = 0; i < size; i++)
-        lept_free((lept_value*)lept_context_pop(c, sizeof(lept_value)));
-    return ret;
-}
-
-static int lept_parse_object(lept_context* c, lept_value* v) {
-    size_t i, size;
-    lept_member m;
-    int ret;
-    EXPECT(c, '{');
-    lept_parse_whitespace(c);
-    if (*c->json == '}') {
-        c->json++;
-        lept_set_object(v, 0);
-        return LEPT_PARSE_OK;
-    }
-    m.k = NULL;
-    size = 0;
-    for (;;) {
-        char* str;
-        lept_init(&m.v);
-        /* parse key */
-        if (*c->json != '"') {
-            ret = LEPT_PARSE_MISS_KEY;
+        lept_parse_whitespace(&c);
+        if (PEEK(&c) != ':') {
+            ret = LEPT_PARSE_MISS_COLON;
             break;
         }
-        if ((ret = lept_parse_string_raw(c, &str, &m.klen)) != LEPT_PARSE_OK)
+        c.json++;
+        lept_parse_whitespace(&c);
+        if ((ret = lept_expect_value(&c)) != LEPT_PARSE_OK)
             break;
-        memcpy(m.k = (char*)malloc(m.klen + 1), str, m.klen);
-        m.k[m.klen] = '\0';
-        /* parse ws colon ws */
-        lept_parse_whitespace(c);
-        if (*c->json != ':') {
-            ret = LEPT_PARSE_MISS_COLON;
+        if (match) {
+            lept_cursor_set(field, obj->doc, c.json);
+            ret = LEPT_PARSE_OK;
             break;
         }
-        c->json++;
-        lept_parse_whitespace(c);
-        /* parse value */
-        if ((ret = lept_parse_value(c, &m.v)) != LEPT_PARSE_OK)
+        if ((ret = lept_skip_value(&c)) != LEPT_PARSE_OK)
             break;
-        memcpy(lept_context_push(c, sizeof(lept_member)), &m, sizeof(lept_member));
-        size++;
-        m.k = NULL; /* ownership is transferred to member on stack */
-        /* parse ws [comma | right-curly-brace] ws */
-        lept_parse_whitespace(c);
-        if (*c->json == ',') {
-            c->json++;
-            lept_parse_whitespace(c);
-        }
-        else if (*c->json == '}') {
-            c->json++;
-            lept_set_object(v, size);
-            memcpy(v->u.o.m, lept_context_pop(c, sizeof(lept_member) * size), sizeof(lept_member) * size);
-            v->u.o.size = size;
-            return LEPT_PARSE_OK;
+        lept_parse_whitespace(&c);
+        if (PEEK(&c) == ',') {
+            c.json++;
+            lept_parse_whitespace(&c);
         }
         else {
-            ret = LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+            ret = PEEK(&c) == '}' ? LEPT_CURSOR_FIELD_NOT_FOUND : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
             break;
         }
     }
-    /* Pop and free members on the stack */
-    free(m.k);
-    for (i = 0; i < size; i++) {
-        lept_member* m = (lept_member*)lept_context_pop(c, sizeof(lept_member));
-        free(m->k);
-        lept_free(&m->v);
-    }
-    v->type = LEPT_NULL;
+    free(c.stack);
     return ret;
 }
 
-static int lept_parse_value(lept_context* c, lept_value* v) {
-    switch (*c->json) {
-        case 't':  return lept_parse_literal(c, v, "true", LEPT_TRUE);
-        case 'f':  return lept_parse_literal(c, v, "false", LEPT_FALSE);
-        case 'n':  return lept_parse_literal(c, v, "null", LEPT_NULL);
-        default:   return lept_parse_number(c, v);
-        case '"':  return lept_parse_string(c, v);
-        case '[':  return lept_parse_array(c, v);
-        case '{':  return lept_parse_object(c, v);
-        case '\0': return LEPT_PARSE_EXPECT_VALUE;
+/* array->elem is NULL before the first call, then the last element returned, then array->json at the end. */
+int lept_cursor_array_next(lept_cursor* array, lept_cursor* element) {
+    lept_context c;
+    int ret, comma = 0;
+    assert(array != NULL && element != NULL && lept_cursor_get_type(array) == LEPT_ARRAY);
+    if (array->elem == array->json)
+        return LEPT_CURSOR_ARRAY_END;
+    lept_cursor_context(&c, array);
+    if (array->elem == NULL)
+        c.json++;
+    else {
+        c.json = array->elem;
+        if ((ret = lept_skip_value(&c)) != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(&c);
+        if (PEEK(&c) == ',') {
+            c.json++;
+            comma = 1;
+        }
+        else if (PEEK(&c) != ']')
+            return LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+    }
+    lept_parse_whitespace(&c);
+    if (PEEK(&c) == ']' && !comma) {
+        array->elem = array->json;
+        return LEPT_CURSOR_ARRAY_END;
     }
+    if ((ret = lept_expect_value(&c)) != LEPT_PARSE_OK)
+        return ret;
+    array->elem = c.json;
+    lept_cursor_set(element, array->doc, c.json);
+    return LEPT_PARSE_OK;
 }
 
-int lept_parse(lept_value* v, const char* json) {
+int lept_cursor_get_double(const lept_cursor* cur, double* n) {
     lept_context c;
+    lept_value v;
     int ret;
-    assert(v != NULL);
-    c.json = json;
-    c.stack = NULL;
-    c.size = c.top = 0;
+    assert(cur != NULL && n != NULL);
+    lept_cursor_context(&c, cur);
+    lept_init(&v);
+    if ((ret = lept_parse_number(&c, &v)) == LEPT_PARSE_OK)
+        *n = lept_get_number(&v);
+    free(c.stack);
+    return ret;
+}
+
+int lept_cursor_get_value(const lept_cursor* cur, lept_value* v) {
+    lept_context c;
+    int ret;
+    assert(cur != NULL && v != NULL);
+    lept_cursor_context(&c, cur);
     lept_init(v);
-    lept_parse_whitespace(&c);
-    if ((ret = lept_parse_value(&c, v)) == LEPT_PARSE_OK) {
-        lept_parse_whitespace(&c);
-        if (*c.json != '\0') {
-            v->type = LEPT_NULL;
-            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
-        }
-    }
-    assert(c.top == 0);
+    ret = lept_parse_value(&c, v);
     free(c.stack);
     return ret;
 }
@@ -371,17 +4051,51 @@ static void lept_stringify_string(lept_context* c, const char* s, size_t len) {
     c->top -= size - (p - head);
 }
 
+static void lept_stringify_integer(lept_context* c, const lept_value* v) {
+    static const char digits2[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char buf[20], *p = buf + sizeof(buf);
+    uint64_t u = v->u.u64;
+    size_t len;
+    if ((v->flags & LEPT_FLAG_INT64) && v->u.i64 < 0) {
+        PUTC(c, '-');
+        u = 0 - u;
+    }
+    /* two digits per division, right to left */
+    while (u >= 100) {
+        unsigned r = (unsigned)(u % 100);
+        u /= 100;
+        *--p = digits2[r * 2 + 1];
+        *--p = digits2[r * 2];
+    }
+    if (u >= 10) {
+        *--p = digits2[u * 2 + 1];
+        *--p = digits2[u * 2];
+    }
+    else
+        *--p = (char)('0' + u);
+    len = buf + sizeof(buf) - p;
+    PUTS(c, p, len);
+}
+
 static void lept_stringify_value(lept_context* c, const lept_value* v) {
     size_t i;
     switch (v->type) {
         case LEPT_NULL:   PUTS(c, "null",  4); break;
         case LEPT_FALSE:  PUTS(c, "false", 5); break;
         case LEPT_TRUE:   PUTS(c, "true",  4); break;
-        case LEPT_NUMBER: c->top -= 32 - sprintf(lept_context_push(c, 32), "%.17g", v->u.n); break;
-        case LEPT_STRING: lept_stringify_string(c, v->u.s.s, v->u.s.len); break;
+        case LEPT_NUMBER:
+            if (v->flags & LEPT_FLAG_INTEGER)
+                lept_stringify_integer(c, v);
+            else
+                c->top -= 32 - sprintf(lept_context_push(c, 32), "%.17g", v->u.n);
+            break;
+        case LEPT_STRING: lept_stringify_string(c, lept_get_string(v), lept_get_string_length(v)); break;
         case LEPT_ARRAY:
             PUTC(c, '[');
-            for (i = 0; i < v->u.a.size; i++) {
+            for (i = 0; i < ASIZE(v); i++) {
                 if (i > 0)
                     PUTC(c, ',');
                 lept_stringify_value(c, &v->u.a.e[i]);
@@ -390,7 +4104,7 @@ static void lept_stringify_value(lept_context* c, const lept_value* v) {
             break;
         case LEPT_OBJECT:
             PUTC(c, '{');
-            for (i = 0; i < v->u.o.size; i++) {
+            for (i = 0; i < OSIZE(v); i++) {
                 if (i > 0)
                     PUTC(c, ',');
                 lept_stringify_string(c, v->u.o.m[i].k, v->u.o.m[i].klen);
@@ -403,6 +4117,49 @@ static void lept_stringify_value(lept_context* c, const lept_value* v) {
     }
 }
 
+/* A stringify buffer kept between calls. */
+struct lept_writer {
+    char* stack;
+    size_t size;
+    size_t keep;
+};
+
+lept_writer* lept_writer_create(void) {
+    lept_writer* w = (lept_writer*)malloc(sizeof(lept_writer));
+    w->stack = NULL;
+    w->size = 0;
+    w->keep = LEPT_PARSE_STACK_KEEP_SIZE;
+    return w;
+}
+
+void lept_writer_set_keep_size(lept_writer* w, size_t size) {
+    assert(w != NULL);
+    w->keep = size;
+}
+
+void lept_writer_free(lept_writer* w) {
+    assert(w != NULL);
+    free(w->stack);
+    free(w);
+}
+
+const char* lept_writer_stringify(lept_writer* w, const lept_value* v, size_t* length) {
+    lept_context c;
+    assert(w != NULL && v != NULL);
+    /* the previous text is given up now, so its buffer may shrink */
+    lept_stack_trim(&w->stack, &w->size, w->keep);
+    c.stack = w->stack;
+    c.size = w->size;
+    c.top = 0;
+    lept_stringify_value(&c, v);
+    if (length)
+        *length = c.top;
+    PUTC(&c, '\0');
+    w->stack = c.stack;
+    w->size = c.size;
+    return c.stack;
+}
+
 char* lept_stringify(const lept_value* v, size_t* length) {
     lept_context c;
     assert(v != NULL);
@@ -419,7 +4176,7 @@ void lept_copy(lept_value* dst, const lept_value* src) {
     assert(src != NULL && dst != NULL && src != dst);
     switch (src->type) {
         case LEPT_STRING:
-            lept_set_string(dst, src->u.s.s, src->u.s.len);
+            lept_set_string(dst, lept_get_string(src), lept_get_string_length(src));
             break;
         case LEPT_ARRAY:
             /* \todo */
@@ -456,23 +4213,32 @@ void lept_free(lept_value* v) {
     assert(v != NULL);
     switch (v->type) {
         case LEPT_STRING:
-            free(v->u.s.s);
+            if (!(v->flags & (LEPT_FLAG_BORROWED | LEPT_FLAG_INLINE)))
+                free(v->u.s.s);
             break;
         case LEPT_ARRAY:
-            for (i = 0; i < v->u.a.size; i++)
+            for (i = 0; i < ASIZE(v); i++)
                 lept_free(&v->u.a.e[i]);
-            free(v->u.a.e);
+            if (!(v->flags & LEPT_FLAG_BORROWED))
+                lept_children_free(v->u.a.e);
             break;
         case LEPT_OBJECT:
-            for (i = 0; i < v->u.o.size; i++) {
-                free(v->u.o.m[i].k);
+            for (i = 0; i < OSIZE(v); i++) {
+                if (!(v->u.o.m[i].kflags & LEPT_FLAG_BORROWED))
+                    free(v->u.o.m[i].k);
                 lept_free(&v->u.o.m[i].v);
             }
-            free(v->u.o.m);
+            if (v->flags & LEPT_FLAG_INDEXED) {
+                free(OINDEX(v->u.o.m));
+                free((char*)v->u.o.m - CHILD_HEADER - INDEX_HEADER);
+            }
+            else if (!(v->flags & LEPT_FLAG_BORROWED))
+                lept_children_free(v->u.o.m);
             break;
         default: break;
     }
     v->type = LEPT_NULL;
+    v->flags = 0;
 }
 
 lept_type lept_get_type(const lept_value* v) {
@@ -487,14 +4253,18 @@ int lept_is_equal(const lept_value* lhs, const lept_value* rhs) {
         return 0;
     switch (lhs->type) {
         case LEPT_STRING:
-            return lhs->u.s.len == rhs->u.s.len && 
-                memcmp(lhs->u.s.s, rhs->u.s.s, lhs->u.s.len) == 0;
+            return lept_get_string_length(lhs) == lept_get_string_length(rhs) &&
+                memcmp(lept_get_string(lhs), lept_get_string(rhs), lept_get_string_length(lhs)) == 0;
         case LEPT_NUMBER:
-            return lhs->u.n == rhs->u.n;
+            if ((lhs->flags & LEPT_FLAG_INTEGER) && (rhs->flags & LEPT_FLAG_INTEGER))
+                /* same bits are the same value unless one side is a negative int64 */
+                return lhs->u.u64 == rhs->u.u64 &&
+                    (lhs->flags == rhs->flags || (lept_is_uint64(lhs) && lept_is_uint64(rhs)));
+            return lept_get_number(lhs) == lept_get_number(rhs);
         case LEPT_ARRAY:
-            if (lhs->u.a.size != rhs->u.a.size)
+            if (ASIZE(lhs) != ASIZE(rhs))
                 return 0;
-            for (i = 0; i < lhs->u.a.size; i++)
+            for (i = 0; i < ASIZE(lhs); i++)
                 if (!lept_is_equal(&lhs->u.a.e[i], &rhs->u.a.e[i]))
                     return 0;
             return 1;
@@ -518,6 +4288,10 @@ void lept_set_boolean(lept_value* v, int b) {
 
 double lept_get_number(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_NUMBER);
+    if (v->flags & LEPT_FLAG_INT64)
+        return (double)v->u.i64;
+    if (v->flags & LEPT_FLAG_UINT64)
+        return (double)v->u.u64;
     return v->u.n;
 }
 
@@ -527,108 +4301,171 @@ void lept_set_number(lept_value* v, double n) {
     v->type = LEPT_NUMBER;
 }
 
+int lept_is_int64(const lept_value* v) {
+    assert(v != NULL);
+    return v->type == LEPT_NUMBER &&
+        ((v->flags & LEPT_FLAG_INT64) || ((v->flags & LEPT_FLAG_UINT64) && !(v->u.u64 >> 63)));
+}
+
+int lept_is_uint64(const lept_value* v) {
+    assert(v != NULL);
+    return v->type == LEPT_NUMBER &&
+        ((v->flags & LEPT_FLAG_UINT64) || ((v->flags & LEPT_FLAG_INT64) && v->u.i64 >= 0));
+}
+
+int64_t lept_get_int64(const lept_value* v) {
+    assert(v != NULL && v->type == LEPT_NUMBER);
+    if (v->flags & LEPT_FLAG_INTEGER)
+        return v->u.i64;
+    return (int64_t)v->u.n;
+}
+
+void lept_set_int64(lept_value* v, int64_t i) {
+    lept_free(v);
+    v->u.i64 = i;
+    v->type = LEPT_NUMBER;
+    v->flags = LEPT_FLAG_INT64;
+}
+
+uint64_t lept_get_uint64(const lept_value* v) {
+    assert(v != NULL && v->type == LEPT_NUMBER);
+    if (v->flags & LEPT_FLAG_INTEGER)
+        return v->u.u64;
+    return (uint64_t)v->u.n;
+}
+
+void lept_set_uint64(lept_value* v, uint64_t u) {
+    lept_free(v);
+    v->u.u64 = u;
+    v->type = LEPT_NUMBER;
+    v->flags = LEPT_FLAG_UINT64;
+}
+
 const char* lept_get_string(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_STRING);
-    return v->u.s.s;
+    return v->flags & LEPT_FLAG_INLINE ? v->u.ss : v->u.s.s;
 }
 
 size_t lept_get_string_length(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_STRING);
-    return v->u.s.len;
+    return v->flags & LEPT_FLAG_INLINE ? INLINE_LEN(v) : SLEN(v);
 }
 
 void lept_set_string(lept_value* v, const char* s, size_t len) {
-    assert(v != NULL && (s != NULL || len == 0));
+    char* p;
+    assert(v != NULL && (s != NULL || len == 0) && !TOO_BIG(len));
     lept_free(v);
-    v->u.s.s = (char*)malloc(len + 1);
-    memcpy(v->u.s.s, s, len);
-    v->u.s.s[len] = '\0';
-    v->u.s.len = len;
+    /* Short strings live in the value itself, saving a malloc() */
+    if (len <= LEPT_STRING_INLINE_MAX) {
+        p = v->u.ss;
+        SET_INLINE_LEN(v, len);
+        v->flags = LEPT_FLAG_INLINE;
+    }
+    else {
+        p = v->u.s.s = (char*)malloc(len + 1);
+        SLEN(v) = len;
+    }
+    memcpy(p, s, len);
+    p[len] = '\0';
     v->type = LEPT_STRING;
 }
 
 void lept_set_array(lept_value* v, size_t capacity) {
-    assert(v != NULL);
+    assert(v != NULL && !TOO_BIG(capacity));
     lept_free(v);
     v->type = LEPT_ARRAY;
-    v->u.a.size = 0;
-    v->u.a.capacity = capacity;
-    v->u.a.e = capacity > 0 ? (lept_value*)malloc(capacity * sizeof(lept_value)) : NULL;
+    ASIZE(v) = 0;
+    v->u.a.e = capacity > 0 ? (lept_value*)lept_children_realloc(NULL, capacity, LEPT_ARRAY) : NULL;
+    SET_ACAPACITY(v, capacity);
 }
 
 size_t lept_get_array_size(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    return v->u.a.size;
+    return ASIZE(v);
 }
 
 size_t lept_get_array_capacity(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    return v->u.a.capacity;
+    return ACAPACITY(v);
+}
+
+/* Moves a borrowed buffer of elements to the heap, where it can be resized. */
+static void lept_own_array(lept_value* v) {
+    if (v->flags & LEPT_FLAG_BORROWED) {
+        size_t capacity = ACAPACITY(v);
+        lept_value* e = (lept_value*)lept_children_realloc(NULL, capacity > 0 ? capacity : 1, LEPT_ARRAY);
+        if (ASIZE(v) > 0)
+            memcpy(e, v->u.a.e, ASIZE(v) * sizeof(lept_value));
+        v->u.a.e = e;
+        v->flags &= ~LEPT_FLAG_BORROWED;
+    }
 }
 
 void lept_reserve_array(lept_value* v, size_t capacity) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.capacity < capacity) {
-        v->u.a.capacity = capacity;
-        v->u.a.e = (lept_value*)realloc(v->u.a.e, capacity * sizeof(lept_value));
+    if (ACAPACITY(v) < capacity) {
+        lept_own_array(v);
+        v->u.a.e = (lept_value*)lept_children_realloc(v->u.a.e, capacity, LEPT_ARRAY);
+        SET_ACAPACITY(v, capacity);
     }
 }
 
 void lept_shrink_array(lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.capacity > v->u.a.size) {
-        v->u.a.capacity = v->u.a.size;
-        v->u.a.e = (lept_value*)realloc(v->u.a.e, v->u.a.capacity * sizeof(lept_value));
+    if (ACAPACITY(v) > ASIZE(v)) {
+        lept_own_array(v);
+        v->u.a.e = (lept_value*)lept_children_realloc(v->u.a.e, ASIZE(v), LEPT_ARRAY);
+        SET_ACAPACITY(v, ASIZE(v));
     }
 }
 
 void lept_clear_array(lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    lept_erase_array_element(v, 0, v->u.a.size);
+    lept_erase_array_element(v, 0, ASIZE(v));
 }
 
 lept_value* lept_get_array_element(lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    assert(index < v->u.a.size);
+    assert(index < ASIZE(v));
     return &v->u.a.e[index];
 }
 
 lept_value* lept_pushback_array_element(lept_value* v) {
-    assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.size == v->u.a.capacity)
-        lept_reserve_array(v, v->u.a.capacity == 0 ? 1 : v->u.a.capacity * 2);
-    lept_init(&v->u.a.e[v->u.a.size]);
-    return &v->u.a.e[v->u.a.size++];
+    assert(v != NULL && v->type == LEPT_ARRAY && !TOO_BIG((size_t)ASIZE(v) + 1));
+    if (ASIZE(v) == ACAPACITY(v))
+        lept_reserve_array(v, ASIZE(v) == 0 ? 1 : ASIZE(v) * 2);
+    lept_init(&v->u.a.e[ASIZE(v)]);
+    return &v->u.a.e[ASIZE(v)++];
 }
 
 void lept_popback_array_element(lept_value* v) {
-    assert(v != NULL && v->type == LEPT_ARRAY && v->u.a.size > 0);
-    lept_free(&v->u.a.e[--v->u.a.size]);
+    assert(v != NULL && v->type == LEPT_ARRAY && ASIZE(v) > 0);
+    lept_free(&v->u.a.e[--ASIZE(v)]);
 }
 
 lept_value* lept_insert_array_element(lept_value* v, size_t index) {
-    assert(v != NULL && v->type == LEPT_ARRAY && index <= v->u.a.size);
+    assert(v != NULL && v->type == LEPT_ARRAY && index <= ASIZE(v));
     /* \todo */
     return NULL;
 }
 
 void lept_erase_array_element(lept_value* v, size_t index, size_t count) {
-    assert(v != NULL && v->type == LEPT_ARRAY && index + count <= v->u.a.size);
+    assert(v != NULL && v->type == LEPT_ARRAY && index + count <= ASIZE(v));
     /* \todo */
 }
 
 void lept_set_object(lept_value* v, size_t capacity) {
-    assert(v != NULL);
+    assert(v != NULL && !TOO_BIG(capacity));
     lept_free(v);
     v->type = LEPT_OBJECT;
-    v->u.o.size = 0;
-    v->u.o.capacity = capacity;
-    v->u.o.m = capacity > 0 ? (lept_member*)malloc(capacity * sizeof(lept_member)) : NULL;
+    OSIZE(v) = 0;
+    v->u.o.m = capacity > 0 ? (lept_member*)lept_children_realloc(NULL, capacity, LEPT_OBJECT) : NULL;
+    SET_OCAPACITY(v, capacity);
 }
 
 size_t lept_get_object_size(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    return v->u.o.size;
+    return OSIZE(v);
 }
 
 size_t lept_get_object_capacity(const lept_value* v) {
@@ -639,6 +4476,7 @@ size_t lept_get_object_capacity(const lept_value* v) {
 
 void lept_reserve_object(lept_value* v, size_t capacity) {
     assert(v != NULL && v->type == LEPT_OBJECT);
+    (void)capacity;
     /* \todo */
 }
 
@@ -654,27 +4492,88 @@ void lept_clear_object(lept_value* v) {
 
 const char* lept_get_object_key(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    assert(index < v->u.o.size);
+    assert(index < OSIZE(v));
     return v->u.o.m[index].k;
 }
 
 size_t lept_get_object_key_length(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    assert(index < v->u.o.size);
+    assert(index < OSIZE(v));
     return v->u.o.m[index].klen;
 }
 
 lept_value* lept_get_object_value(lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    assert(index < v->u.o.size);
+    assert(index < OSIZE(v));
     return &v->u.o.m[index].v;
 }
 
+/*
+ * Brings the index of a large object up to date: members appended since it
+ * was built are added, and a table over half full is rebuilt twice as large.
+ * The first time, the members move to a heap block with room for the index
+ * pointer in front.
+ */
+void lept_index_object(lept_value* v) {
+    lept_object_index* x;
+    lept_member* m;
+    uint32_t* slots;
+    size_t i, j, n, size;
+    assert(v != NULL && v->type == LEPT_OBJECT);
+    if ((size = OSIZE(v)) < LEPT_OBJECT_INDEX_MIN)
+        return;
+    if (!(v->flags & LEPT_FLAG_INDEXED)) {
+        size_t capacity = OCAPACITY(v);
+        char* p = (char*)malloc(INDEX_HEADER + CHILD_HEADER + capacity * sizeof(lept_member));
+        m = (lept_member*)lept_children_init(p + INDEX_HEADER, capacity);
+        memcpy(m, v->u.o.m, size * sizeof(lept_member));
+        if (!(v->flags & LEPT_FLAG_BORROWED))
+            lept_children_free(v->u.o.m);
+        v->u.o.m = m;
+        v->flags = LEPT_FLAG_INDEXED;
+        OINDEX(m) = NULL;
+    }
+    m = v->u.o.m;
+    x = OINDEX(m);
+    if (x == NULL || x->count > size || 2 * size > x->mask + 1) {
+        for (n = 2 * LEPT_OBJECT_INDEX_MIN; n < 4 * size; n *= 2)
+            ;
+        free(x);
+        x = (lept_object_index*)calloc(1, sizeof(lept_object_index) + n * 2 * sizeof(uint32_t));
+        x->mask = n - 1;
+        OINDEX(m) = x;
+    }
+    slots = INDEX_SLOTS(x);
+    for (i = x->count; i < size; i++) {
+        uint32_t h = lept_hash(m[i].k, m[i].klen);
+        for (j = h & x->mask; slots[2 * j] != 0; j = (j + 1) & x->mask)
+            ;
+        slots[2 * j] = (uint32_t)(i + 1);
+        slots[2 * j + 1] = h;
+    }
+    x->count = size;
+}
+
 size_t lept_find_object_index(const lept_value* v, const char* key, size_t klen) {
     size_t i;
     assert(v != NULL && v->type == LEPT_OBJECT && key != NULL);
-    for (i = 0; i < v->u.o.size; i++)
-        if (v->u.o.m[i].klen == klen && memcmp(v->u.o.m[i].k, key, klen) == 0)
+    /* Only read here: an index missing members appended since it was built is not used */
+    if ((v->flags & LEPT_FLAG_INDEXED) && OINDEX(v->u.o.m)->count == OSIZE(v)) {
+        const lept_object_index* x = OINDEX(v->u.o.m);
+        const uint32_t* slots = INDEX_SLOTS(x);
+        uint32_t h = lept_hash(key, klen);
+        /* Members of one key sit along the probe sequence in their order, so the first one is found */
+        for (i = h & x->mask; slots[2 * i] != 0; i = (i + 1) & x->mask)
+            if (slots[2 * i + 1] == h) {
+                const lept_member* m = &v->u.o.m[slots[2 * i] - 1];
+                if (m->klen == klen && (m->k == key || memcmp(m->k, key, klen) == 0))
+                    return slots[2 * i] - 1;
+            }
+        return LEPT_KEY_NOT_EXIST;
+    }
+    /* An interned key (lept_document_find_key()) matches by address. */
+    for (i = 0; i < OSIZE(v); i++)
+        if (v->u.o.m[i].klen == klen && (v->u.o.m[i].k == key || memcmp(v->u.o.m[i].k, key, klen) == 0))
             return i;
     return LEPT_KEY_NOT_EXIST;
 }
@@ -686,11 +4585,12 @@ lept_value* lept_find_object_value(lept_value* v, const char* key, size_t klen)
 
 lept_value* lept_set_object_value(lept_value* v, const char* key, size_t klen) {
     assert(v != NULL && v->type == LEPT_OBJECT && key != NULL);
+    (void)klen;
     /* \todo */
     return NULL;
 }
 
 void lept_remove_object_value(lept_value* v, size_t index) {
-    assert(v != NULL && v->type == LEPT_OBJECT && index < v->u.o.size);
+    assert(v != NULL && v->type == LEPT_OBJECT && index < OSIZE(v));
     /* \todo */
 }
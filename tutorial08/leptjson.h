@@ -2,6 +2,7 @@
 #define LEPTJSON_H__
 
 #include <stddef.h> /* size_t */
+#include <stdint.h> /* int64_t, uint64_t */
 
 typedef enum { LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_STRING, LEPT_ARRAY, LEPT_OBJECT } lept_type;
 
@@ -10,20 +11,65 @@ typedef enum { LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_STRING, LEPT_
 typedef struct lept_value lept_value;
 typedef struct lept_member lept_member;
 
+#ifdef LEPT_COMPACT_VALUE
+/*
+ * Compact layout, 16 bytes on 64-bit targets: a string, array or object holds
+ * at most 2^32 - 1 bytes or children, and the capacity of an array or object
+ * is kept in front of its children instead of in the value.
+ */
+struct lept_value {
+    union {
+        struct { lept_member* m; }o;                        /* object: members */
+        struct { lept_value*  e; }a;                        /* array:  elements */
+        struct { char* s; }s;                               /* string: null-terminated string */
+        char ss[sizeof(double)];                            /* string with LEPT_FLAG_INLINE: chars, '\0' */
+        double n;                                           /* number */
+        int64_t i64;                                        /* number with LEPT_FLAG_INT64 */
+        uint64_t u64;                                       /* number with LEPT_FLAG_UINT64 */
+    }u;
+    uint32_t size;                                          /* string length, element or member count */
+    unsigned char type;                                     /* lept_type */
+    unsigned char flags;                                    /* LEPT_FLAG_* for the string/array/object buffer */
+};
+
+struct lept_member {
+    char* k; uint32_t klen; /* member key string, key string length */
+    unsigned kflags;        /* LEPT_FLAG_* for the key string */
+    lept_value v;           /* member value */
+};
+#else
 struct lept_value {
     union {
         struct { lept_member* m; size_t size, capacity; }o; /* object: members, member count, capacity */
         struct { lept_value*  e; size_t size, capacity; }a; /* array:  elements, element count, capacity */
         struct { char* s; size_t len; }s;                   /* string: null-terminated string, string length */
+        char ss[3 * sizeof(size_t)];                        /* string with LEPT_FLAG_INLINE: chars, '\0', length last */
         double n;                                           /* number */
+        int64_t i64;                                        /* number with LEPT_FLAG_INT64 */
+        uint64_t u64;                                       /* number with LEPT_FLAG_UINT64 */
     }u;
     lept_type type;
+    unsigned flags;                                         /* LEPT_FLAG_* for the string/array/object buffer */
 };
 
 struct lept_member {
     char* k; size_t klen;   /* member key string, key string length */
+    unsigned kflags;        /* LEPT_FLAG_* for the key string */
     lept_value v;           /* member value */
 };
+#endif
+
+#define LEPT_FLAG_BORROWED 0x1  /* buffer points into memory owned elsewhere; lept_free() does not free it */
+#define LEPT_FLAG_INT64    0x2  /* number is stored exactly in u.i64 */
+#define LEPT_FLAG_UINT64   0x4  /* number is stored exactly in u.u64 (above INT64_MAX when parsed) */
+#define LEPT_FLAG_INLINE   0x8  /* string of at most LEPT_STRING_INLINE_MAX chars is stored in u.ss */
+#define LEPT_FLAG_INDEXED  0x10 /* object members have a hash index in front (lept_index_object()) */
+
+#ifdef LEPT_COMPACT_VALUE
+#define LEPT_STRING_INLINE_MAX (sizeof(double) - 1)
+#else
+#define LEPT_STRING_INLINE_MAX (3 * sizeof(size_t) - 2)
+#endif
 
 enum {
     LEPT_PARSE_OK = 0,
@@ -39,13 +85,174 @@ enum {
     LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET,
     LEPT_PARSE_MISS_KEY,
     LEPT_PARSE_MISS_COLON,
-    LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET
+    LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET,
+    LEPT_PARSE_DEPTH_EXCEEDED,
+    LEPT_PARSE_INVALID_UTF8,        /* LEPT_PARSE_FLAG_VALIDATE_UTF8: a string holds ill-formed UTF-8 */
+    LEPT_PARSE_DUPLICATE_KEY,       /* LEPT_PARSE_FLAG_DUPLICATES_REJECT: an object repeats a key */
+    LEPT_PARSE_SIZE_TOO_BIG,        /* LEPT_COMPACT_VALUE: a string, key, array or object is past 2^32 - 1 */
+    LEPT_CURSOR_FIELD_NOT_FOUND,    /* lept_cursor_find_field(): no member has the key */
+    LEPT_CURSOR_ARRAY_END,          /* lept_cursor_array_next(): no more elements */
+    LEPT_STREAM_END,                /* lept_stream_next(): only whitespace is left */
+    LEPT_FILE_IO_ERROR              /* lept_parse_file(): the file cannot be opened, mapped or read */
 };
 
-#define lept_init(v) do { (v)->type = LEPT_NULL; } while(0)
+/*
+ * A read-only document in three contiguous buffers. Values are addressed by
+ * their index in words, the root being 0. Arrays and objects span their
+ * children up to a closing word; an object member is a string word for the
+ * key followed by the value.
+ */
+typedef struct {
+    uint64_t* words;    /* one per value, key and container end: type tag in the top byte, payload below */
+    size_t nwords;
+    uint64_t* numbers;  /* double, int64_t or uint64_t bits, as the tag says */
+    char* strings;      /* each string is a 32-bit length, the bytes and '\0' */
+}lept_tape;
+
+/* A JSON text read on demand; the text must outlive the document and its cursors. */
+typedef struct {
+    const char* json;
+    size_t len;
+}lept_doc;
+
+typedef struct {
+    const lept_doc* doc;
+    const char* json;   /* first byte of the value */
+    const char* elem;   /* array iteration state of lept_cursor_array_next() */
+}lept_cursor;
+
+/*
+ * Callbacks of lept_parse_sax(), each given the ctx pointer. A NULL callback
+ * is skipped; int64/uint64 may be NULL to have integers reported as number.
+ * Strings and keys are not null-terminated and are only valid during the
+ * call. Returning anything but LEPT_PARSE_OK stops the parse with that value.
+ */
+typedef struct {
+    int (*null)(void* ctx);
+    int (*boolean)(void* ctx, int b);
+    int (*number)(void* ctx, double n);
+    int (*int64)(void* ctx, int64_t i);
+    int (*uint64)(void* ctx, uint64_t u);
+    int (*string)(void* ctx, const char* s, size_t len);
+    int (*start_object)(void* ctx);
+    int (*key)(void* ctx, const char* k, size_t klen);
+    int (*end_object)(void* ctx);
+    int (*start_array)(void* ctx);
+    int (*end_array)(void* ctx);
+}lept_handler;
+
+/* Successive root values of one buffer, e.g. JSON Lines or whitespace-separated JSON. */
+typedef struct {
+    const char* json;
+    size_t len, pos;    /* the next document starts at or after pos */
+    size_t offset;      /* byte offset of the document last returned by lept_stream_next() */
+    char* stack;        /* parse stack, kept from one document to the next */
+    size_t size;
+    int ret;            /* the first error, returned from then on */
+}lept_stream;
+
+/*
+ * Called by lept_parse_lines() for each non-blank line, in order, with the
+ * line's byte offset, its parse result and value. The value is freed on
+ * return unless taken with lept_move(). A non-zero return stops the parse.
+ */
+typedef int (*lept_line_callback)(void* ctx, size_t offset, int ret, lept_value* v);
+
+/*
+ * A reusable parser: whole texts with lept_parser_parse(), or texts pushed in
+ * chunks split anywhere. Its stack is kept from one text to the next, up to
+ * the keep size (LEPT_PARSE_STACK_KEEP_SIZE unless set).
+ */
+typedef struct lept_parser lept_parser;
+
+/* A reusable stringify buffer, kept like the parser's stack. */
+typedef struct lept_writer lept_writer;
+
+/*
+ * A parsed tree whose containers, strings and keys all live in one arena,
+ * released together. Values of the tree may be changed like any other; one
+ * moved out with lept_move() still points into the arena.
+ *
+ * With LEPT_PARSE_FLAG_INTERN_KEYS, keys are shared through a hash table the
+ * document keeps across parses: a record layout met again costs no copy, and
+ * a key from lept_document_find_key() is found in an object by its address.
+ */
+typedef struct lept_document lept_document;
+
+#define lept_init(v) do { (v)->type = LEPT_NULL; (v)->flags = 0; } while(0)
+
+/* lept_parse_ex() flags */
+#define LEPT_PARSE_FLAG_PADDED 0x1  /* LEPT_PARSE_PADDING readable bytes follow json[len], SIMD may over-read */
+#define LEPT_PARSE_FLAG_INDEXED 0x2 /* build a structural index of the whole input first, then parse from it */
+#define LEPT_PARSE_FLAG_POPULATE 0x4    /* lept_parse_file(): read the whole file in when mapping it (MAP_POPULATE) */
+#define LEPT_PARSE_FLAG_HUGEPAGES 0x8   /* lept_parse_file(): ask for huge pages (MADV_HUGEPAGE) */
+#define LEPT_PARSE_FLAG_VALIDATE_UTF8 0x10  /* fail with LEPT_PARSE_INVALID_UTF8 on ill-formed UTF-8 in strings */
+#define LEPT_PARSE_FLAG_INTERN_KEYS 0x20    /* lept_document_parse(): equal keys share one copy, kept for later texts */
+#define LEPT_PARSE_FLAG_DUPLICATES_REJECT 0x40  /* fail with LEPT_PARSE_DUPLICATE_KEY when an object repeats a key */
+#define LEPT_PARSE_FLAG_DUPLICATES_FIRST 0x80   /* keep only the first member of a repeated key */
+#define LEPT_PARSE_FLAG_DUPLICATES_LAST 0x100   /* keep the last value of a repeated key, where the key first appeared */
+
+#define LEPT_PARSE_PADDING 32
+
+/* Arrays and objects nested deeper than this fail with LEPT_PARSE_DEPTH_EXCEEDED. */
+#ifndef LEPT_PARSE_MAX_DEPTH
+#define LEPT_PARSE_MAX_DEPTH 1024
+#endif
 
 int lept_parse(lept_value* v, const char* json);
+int lept_parse_n(lept_value* v, const char* json, size_t len);
+int lept_parse_ex(lept_value* v, const char* json, size_t len, unsigned flags);
+int lept_parse_insitu(lept_value* v, char* json);
+int lept_parse_file(lept_value* v, const char* path, unsigned flags);   /* memory-mapped where available */
+int lept_validate(const char* json, size_t len, size_t* err_offset);     /* lept_parse_n()'s result, without building a value */
+int lept_parse_sax(const lept_handler* h, void* ctx, const char* json);
+lept_parser* lept_parser_create(void);
+void lept_parser_set_keep_size(lept_parser* p, size_t size);
+int lept_parser_parse(lept_parser* p, lept_value* v, const char* json, size_t len, unsigned flags); /* as lept_parse_ex() */
+int lept_parser_feed(lept_parser* p, const char* chunk, size_t len);   /* an error found early is returned at once */
+int lept_parser_finish(lept_parser* p, lept_value* v);                 /* then p can parse the next text */
+void lept_parser_free(lept_parser* p);
+lept_document* lept_document_create(void);
+int lept_document_parse(lept_document* d, const char* json, size_t len, unsigned flags);   /* as lept_parse_ex() */
+lept_value* lept_document_root(lept_document* d);
+const char* lept_document_find_key(const lept_document* d, const char* key, size_t klen);  /* interned copy, or NULL */
+void lept_document_reset(lept_document* d);    /* frees the tree, keeping the arena's memory */
+void lept_document_reset_unchanged(lept_document* d);  /* as lept_document_reset(), without the walk: no value set or indexed since the parse */
+void lept_document_free(lept_document* d);
+void lept_stream_init(lept_stream* s, const char* json, size_t len);
+int lept_stream_next(lept_stream* s, lept_value* v);
+void lept_stream_free(lept_stream* s);
+/* JSON Lines, parsed by up to `threads` threads when built with LEPT_THREADS; returns the callback's stop value or 0. */
+int lept_parse_lines(const char* json, size_t len, unsigned threads, lept_line_callback f, void* ctx);
 char* lept_stringify(const lept_value* v, size_t* length);
+lept_writer* lept_writer_create(void);
+void lept_writer_set_keep_size(lept_writer* w, size_t size);
+const char* lept_writer_stringify(lept_writer* w, const lept_value* v, size_t* length); /* valid until the next call */
+void lept_writer_free(lept_writer* w);
+
+int lept_parse_tape(lept_tape* t, const char* json, size_t len);
+void lept_tape_free(lept_tape* t);
+lept_type lept_tape_get_type(const lept_tape* t, size_t i);
+int lept_tape_get_boolean(const lept_tape* t, size_t i);
+double lept_tape_get_number(const lept_tape* t, size_t i);
+const char* lept_tape_get_string(const lept_tape* t, size_t i);
+size_t lept_tape_get_string_length(const lept_tape* t, size_t i);
+size_t lept_tape_get_size(const lept_tape* t, size_t i);
+size_t lept_tape_first(const lept_tape* t, size_t i);  /* first element, or first member key */
+size_t lept_tape_end(const lept_tape* t, size_t i);    /* one past the last element or member */
+size_t lept_tape_next(const lept_tape* t, size_t i);   /* the value following value i */
+size_t lept_tape_find_object_value(const lept_tape* t, size_t i, const char* key, size_t klen);
+void lept_tape_to_value(const lept_tape* t, size_t i, lept_value* v);
+void lept_tape_from_value(lept_tape* t, const lept_value* v);
+
+/* On-demand access: only the values a getter reaches are decoded and checked, the rest is skipped. */
+void lept_doc_init(lept_doc* d, const char* json, size_t len);
+int lept_doc_root(const lept_doc* d, lept_cursor* root);
+lept_type lept_cursor_get_type(const lept_cursor* cur);
+int lept_cursor_find_field(const lept_cursor* obj, const char* key, size_t klen, lept_cursor* field);
+int lept_cursor_array_next(lept_cursor* array, lept_cursor* element);
+int lept_cursor_get_double(const lept_cursor* cur, double* n);
+int lept_cursor_get_value(const lept_cursor* cur, lept_value* v);
 
 void lept_copy(lept_value* dst, const lept_value* src);
 void lept_move(lept_value* dst, lept_value* src);
@@ -63,7 +270,18 @@ void lept_set_boolean(lept_value* v, int b);
 
 double lept_get_number(const lept_value* v);
 void lept_set_number(lept_value* v, double n);
+int lept_is_int64(const lept_value* v);
+int lept_is_uint64(const lept_value* v);
+int64_t lept_get_int64(const lept_value* v);
+void lept_set_int64(lept_value* v, int64_t i);
+uint64_t lept_get_uint64(const lept_value* v);
+void lept_set_uint64(lept_value* v, uint64_t u);
 
+/*
+ * A string of at most LEPT_STRING_INLINE_MAX chars lives in v itself: its
+ * pointer is only valid while v stays put, not after lept_move()/lept_swap()
+ * on v or a reallocation of the parent's children (such as a pushback).
+ */
 const char* lept_get_string(const lept_value* v);
 size_t lept_get_string_length(const lept_value* v);
 void lept_set_string(lept_value* v, const char* s, size_t len);
@@ -89,6 +307,13 @@ void lept_clear_object(lept_value* v);
 const char* lept_get_object_key(const lept_value* v, size_t index);
 size_t lept_get_object_key_length(const lept_value* v, size_t index);
 lept_value* lept_get_object_value(lept_value* v, size_t index);
+/*
+ * The first of the members with that key. Lookups only read the object, so
+ * threads may share a tree; they scan the members, or search the hash index
+ * lept_index_object() builds for an object of LEPT_OBJECT_INDEX_MIN (16)
+ * members or more, which must not run concurrently with lookups.
+ */
+void lept_index_object(lept_value* v);
 size_t lept_find_object_index(const lept_value* v, const char* key, size_t klen);
 lept_value* lept_find_object_value(lept_value* v, const char* key, size_t klen);
 lept_value* lept_set_object_value(lept_value* v, const char* key, size_t klen);
@@ -69,6 +69,7 @@ static void test_parse_false() {
         EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
         EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));\
         EXPECT_EQ_DOUBLE(expect, lept_get_number(&v));\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(json, strlen(json), NULL));\
         lept_free(&v);\
     } while(0)
 
@@ -102,6 +103,124 @@ static void test_parse_number() {
     TEST_NUMBER(-2.2250738585072014e-308, "-2.2250738585072014e-308");
     TEST_NUMBER( 1.7976931348623157e+308, "1.7976931348623157e+308");  /* Max double */
     TEST_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
+
+    /* beyond the exact fast path, and more than 19 significant digits */
+    TEST_NUMBER(0.1, "0.1");
+    TEST_NUMBER(1e23, "1e23");
+    TEST_NUMBER(9007199254740992.0, "9007199254740993"); /* 2^53 + 1, ties to even */
+    TEST_NUMBER(9007199254740994.0, "9007199254740993.0000000000000000001");
+    TEST_NUMBER(1.2345678901234568e+29, "123456789012345678901234567890");
+    TEST_NUMBER(1.2345678901234568e-21, "0.00000000000000000000123456789012345678901");
+    TEST_NUMBER(2.2250738585072011e-308, "2.2250738585072011e-308");
+    TEST_NUMBER(0.0, "0e999999999");
+
+    /* the decimal slow path: exact halfway points and their neighbours */
+    TEST_NUMBER(1.0, "1.00000000000000011102230246251565404236316680908203125");
+    TEST_NUMBER(1.0000000000000002, "1.00000000000000011102230246251565404236316680908203126");
+    TEST_NUMBER(9007199254740992.0, "9007199254740993.00000000000000000000000000000");
+    TEST_NUMBER(0.0, "2.4703282292062327e-324");
+    TEST_NUMBER(4.9406564584124654e-324, "2.4703282292062328e-324");
+    TEST_NUMBER(-4.9406564584124654e-324, "-2.4703282292062328e-324");
+    TEST_NUMBER(1.7976931348623157e+308, "1.7976931348623158e308");
+}
+
+/* before, n zeros, then after */
+static char* number_of(const char* before, size_t n, const char* after) {
+    size_t lb = strlen(before), la = strlen(after);
+    char* json = (char*)malloc(lb + n + la + 1);
+    memcpy(json, before, lb);
+    memset(json + lb, '0', n);
+    memcpy(json + lb + n, after, la + 1);
+    return json;
+}
+
+static void test_parse_number_long_exponent() {
+    static const size_t zeros[] = { 400, 300000 };
+    char after[80], *json;
+    size_t i;
+    /* the exponent is offset by the digit count before it is clamped */
+    for (i = 0; i < sizeof(zeros) / sizeof(zeros[0]); i++) {
+        sprintf(after, "1e%lu", (unsigned long)zeros[i]);
+        json = number_of("0.", zeros[i], after);
+        TEST_NUMBER(0.1, json);
+        free(json);
+        sprintf(after, "1e%lu", (unsigned long)zeros[i] + 1);
+        json = number_of("0.", zeros[i], after);
+        TEST_NUMBER(1.0, json);
+        free(json);
+        sprintf(after, "e-%lu", (unsigned long)zeros[i] + 1);
+        json = number_of("1", zeros[i], after);
+        TEST_NUMBER(0.1, json);
+        free(json);
+        sprintf(after, "e-%lu", (unsigned long)zeros[i] - 300);
+        json = number_of("1", zeros[i], after);
+        TEST_NUMBER(1e300, json);
+        free(json);
+        /* through the decimal slow path: 1 + 2^-53, a tie rounded to even */
+        sprintf(after, "100000000000000011102230246251565404236316680908203125e%lu", (unsigned long)zeros[i] + 1);
+        json = number_of("0.", zeros[i], after);
+        TEST_NUMBER(1.0, json);
+        free(json);
+    }
+    TEST_NUMBER(0.0, "1e-99999999999999999999");
+}
+
+#define TEST_INT64(expect, json)\
+    do {\
+        lept_value v;\
+        lept_init(&v);\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
+        EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));\
+        EXPECT_TRUE(lept_is_int64(&v));\
+        EXPECT_TRUE(lept_get_int64(&v) == (expect));\
+        lept_free(&v);\
+    } while(0)
+
+#define TEST_UINT64(expect, json)\
+    do {\
+        lept_value v;\
+        lept_init(&v);\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
+        EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));\
+        EXPECT_TRUE(lept_is_uint64(&v));\
+        EXPECT_TRUE(lept_get_uint64(&v) == (expect));\
+        lept_free(&v);\
+    } while(0)
+
+static void test_parse_integer() {
+    lept_value v;
+
+    TEST_INT64(0, "0");
+    TEST_INT64(1, "1");
+    TEST_INT64(-1, "-1");
+    TEST_INT64(9007199254740993, "9007199254740993"); /* 2^53 + 1 */
+    TEST_INT64(9223372036854775807, "9223372036854775807"); /* INT64_MAX */
+    TEST_INT64(-9223372036854775807 - 1, "-9223372036854775808"); /* INT64_MIN */
+    TEST_UINT64(9223372036854775808u, "9223372036854775808");
+    TEST_UINT64(18446744073709551615u, "18446744073709551615"); /* UINT64_MAX */
+
+    /* falls back to double: negative zero, fraction, exponent, out of range */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "-0"));
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "1.0"));
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "1e2"));
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "18446744073709551616"));
+    EXPECT_FALSE(lept_is_uint64(&v));
+    EXPECT_EQ_DOUBLE(18446744073709551616.0, lept_get_number(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "-9223372036854775809"));
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_EQ_DOUBLE(-9223372036854775808.0, lept_get_number(&v));
+    lept_free(&v);
+
+    /* below INT64_MIN with 20 digits: the 20th digit must not be folded in twice */
+    TEST_NUMBER(-9223372036854775809.0, "-9223372036854775809");
+    TEST_NUMBER(-1e19, "-10000000000000000000");
+    TEST_NUMBER(-18446744073709551615.0, "-18446744073709551615");
+    TEST_NUMBER(-18446744073709551616.0, "-18446744073709551616");
+    TEST_NUMBER(-99999999999999999999.0, "-99999999999999999999");
 }
 
 #define TEST_STRING(expect, json)\
@@ -111,6 +230,7 @@ static void test_parse_number() {
         EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
         EXPECT_EQ_INT(LEPT_STRING, lept_get_type(&v));\
         EXPECT_EQ_STRING(expect, lept_get_string(&v), lept_get_string_length(&v));\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(json, strlen(json), NULL));\
         lept_free(&v);\
     } while(0)
 
@@ -125,6 +245,14 @@ static void test_parse_string() {
     TEST_STRING("\xE2\x82\xAC", "\"\\u20AC\""); /* Euro sign U+20AC */
     TEST_STRING("\xF0\x9D\x84\x9E", "\"\\uD834\\uDD1E\"");  /* G clef sign U+1D11E */
     TEST_STRING("\xF0\x9D\x84\x9E", "\"\\ud834\\udd1e\"");  /* G clef sign U+1D11E */
+
+    /* long runs without escapes, crossing SIMD block boundaries */
+    TEST_STRING("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ",
+        "\"0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ\"");
+    TEST_STRING("0123456789abcdefghijklmnopqrstuvwxyz\"ABCDEFGHIJKLMNOPQRSTUVWXYZ\\0123456789\n",
+        "\"0123456789abcdefghijklmnopqrstuvwxyz\\\"ABCDEFGHIJKLMNOPQRSTUVWXYZ\\\\0123456789\\n\"");
+    TEST_STRING("\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC",
+        "\"\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\"");
 }
 
 static void test_parse_array() {
@@ -226,6 +354,143 @@ static void test_parse_object() {
     lept_free(&v);
 }
 
+/* Parses the first len bytes of json from an exact-size heap copy, so over-reads are caught by sanitizers. */
+#define TEST_PARSE_N(error, json, len)\
+    do {\
+        lept_value v;\
+        char* buf = (char*)malloc(len);\
+        memcpy(buf, json, len);\
+        lept_init(&v);\
+        EXPECT_EQ_INT(error, lept_parse_n(&v, buf, len));\
+        lept_free(&v);\
+        free(buf);\
+    } while(0)
+
+static void test_parse_n() {
+    lept_value v;
+    char padded[64];
+
+    TEST_PARSE_N(LEPT_PARSE_OK, "123456", 3);
+    TEST_PARSE_N(LEPT_PARSE_OK, "truex", 4);
+    TEST_PARSE_N(LEPT_PARSE_OK, "\"abc\"xyz", 5);
+    TEST_PARSE_N(LEPT_PARSE_OK, "[1,2]]", 5);
+    TEST_PARSE_N(LEPT_PARSE_OK, "{\"a\":\"0123456789abcdefghijklmnopqrstuvwxyz\"}  ", 46);
+    TEST_PARSE_N(LEPT_PARSE_EXPECT_VALUE, "", 0);
+    TEST_PARSE_N(LEPT_PARSE_EXPECT_VALUE, "                                       x", 39);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, "null", 3);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, "1.5", 2);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, "1e10", 2);
+    TEST_PARSE_N(LEPT_PARSE_MISS_QUOTATION_MARK, "\"abc\"", 4);
+    TEST_PARSE_N(LEPT_PARSE_MISS_QUOTATION_MARK, "\"0123456789abcdefghijklmnopqrstuvwxyz\"", 37);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_STRING_ESCAPE, "\"\\n\"", 2);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_UNICODE_HEX, "\"\\u0041\"", 5);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD834\\uDD1E\"", 8);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_STRING_CHAR, "\"a\0b\"", 5); /* '\0' is data, not the end */
+    TEST_PARSE_N(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1,2]", 4);
+    TEST_PARSE_N(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":1}", 6);
+    TEST_PARSE_N(LEPT_PARSE_ROOT_NOT_SINGULAR, "1 2", 3);
+
+    /* padded input: whatever follows the end must not be parsed */
+    memset(padded, '"', sizeof(padded));
+    memcpy(padded, "[\"abc\",   1]", 12);
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, padded, 12, LEPT_PARSE_FLAG_PADDED));
+    EXPECT_EQ_SIZE_T(2, lept_get_array_size(&v));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, lept_parse_ex(&v, padded, 4, LEPT_PARSE_FLAG_PADDED));
+    memset(padded, ' ', sizeof(padded));
+    padded[0] = '1';
+    padded[sizeof(padded) - LEPT_PARSE_PADDING - 1] = 'x';
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, padded, sizeof(padded) - LEPT_PARSE_PADDING - 1, LEPT_PARSE_FLAG_PADDED));
+    lept_free(&v);
+}
+
+/* The structural index must not change the result or the error code. */
+#define TEST_PARSE_INDEXED(json, len)\
+    do {\
+        lept_value v1, v2;\
+        int ret;\
+        lept_init(&v1);\
+        lept_init(&v2);\
+        ret = lept_parse_n(&v1, json, len);\
+        EXPECT_EQ_INT(ret, lept_parse_ex(&v2, json, len, LEPT_PARSE_FLAG_INDEXED));\
+        if (ret == LEPT_PARSE_OK) {\
+            char* json1 = lept_stringify(&v1, NULL);\
+            char* json2 = lept_stringify(&v2, NULL);\
+            EXPECT_EQ_BASE(strcmp(json1, json2) == 0, json1, json2, "%s");\
+            free(json1);\
+            free(json2);\
+        }\
+        lept_free(&v1);\
+        lept_free(&v2);\
+    } while(0)
+
+static void test_parse_indexed() {
+    static const char* inputs[] = {
+        " { \"a\" : [ 1 , 2.5e3 , -0 , true , false , null ] , \"b\" : { } , \"c\" : [ ] } ",
+        "\n\t[\r\n\"x\" ,\"y\\\"\" ,\"\\\\\" ,\"\\\\\\\" ]\" ]\n",
+        "[ \"[not] {structural}, : \" , \"\\u005B\" ]",
+        "", " ", "  1  ", " 1 2", "[1x]", "[1 x]", "[ \"a\" x]", "[ 1 , ]", "{ \"a\" : 1 , }",
+        "{ \"a\" 1 }", "{ 1 : 1 }", "[ \"abc ]", "[ \"a\\q\" ]", "[ tru e ]", "[ nul ]",
+        "[ 1 }", "{ \"a\" : 1 ]", "[ [ ] ", "[\"\\\"\" ]", " \" \\\" \" ]",
+        "{\"a\":[1,\"x\",{\"b\":\"c\",\"d\":[3]}],\"e\" 1}", "[[1,\"y\"],[3,\"x\",[4,5 }]]", "[{\"k\":\"v\",\"l\":[1,{}]},[]",
+        "[ \"a\nb\" ]", "[ \"\\u0041\\t\\/\" , \"\\uD834\\uDD1E\" ]", "[ \"a\\\tb\" ]", "[ truex ]", "[ true1 ]",
+        "[ false\t, null\n]", "[truefalse]", "[\"x\"true]", "[ nulll ]", "true", " false ", "nul"
+    };
+    char json[512];
+    size_t i, k;
+    lept_value v;
+    for (i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+        TEST_PARSE_INDEXED(inputs[i], strlen(inputs[i]));
+
+    /* containers are allocated at their exact size */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, "[[1,2,3],[],{\"a\":[4]}]", 22, LEPT_PARSE_FLAG_INDEXED));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_capacity(&v));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_capacity(lept_get_array_element(&v, 0)));
+    EXPECT_EQ_SIZE_T(0, lept_get_array_capacity(lept_get_array_element(&v, 1)));
+    EXPECT_EQ_SIZE_T(1, lept_get_array_capacity(lept_find_object_value(lept_get_array_element(&v, 2), "a", 1)));
+    lept_free(&v);
+
+    /* escapes, strings and tokens straddling the 64-byte blocks */
+    for (k = 0; k < 140; k++) {
+        memset(json, ' ', k);
+        strcpy(json + k, "[\"\\\\\",\"\\\"]\",   12345,\"\\\\\\\"\"  ,  true  ]");
+        TEST_PARSE_INDEXED(json, strlen(json));
+        json[k] = '"';
+        strcpy(json + k + 1, "\\\\\\\" x \"  ");
+        TEST_PARSE_INDEXED(json, strlen(json));
+        memset(json + k, '\\', 70);
+        strcpy(json + k + 70, "\" ]  [");
+        json[0] = '[';
+        json[1] = '"';
+        TEST_PARSE_INDEXED(json, strlen(json));
+    }
+}
+
+static void test_parse_insitu() {
+    char json[] = "{ \"k\\u0065y\" : [ \"Hello\\nWorld\", \"\\uD834\\uDD1E\", 1 ], \"s\" : \"abc\" }";
+    lept_value v, *a;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v, json));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+    EXPECT_EQ_SIZE_T(2, lept_get_object_size(&v));
+    EXPECT_EQ_STRING("key", lept_get_object_key(&v, 0), lept_get_object_key_length(&v, 0));
+    EXPECT_TRUE(lept_get_object_key(&v, 0) > json && lept_get_object_key(&v, 0) < json + sizeof(json));
+    a = lept_get_object_value(&v, 0);
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(a));
+    EXPECT_EQ_STRING("Hello\nWorld", lept_get_string(lept_get_array_element(a, 0)), lept_get_string_length(lept_get_array_element(a, 0)));
+    EXPECT_TRUE(lept_get_string(lept_get_array_element(a, 0)) > json);
+    EXPECT_EQ_STRING("\xF0\x9D\x84\x9E", lept_get_string(lept_get_array_element(a, 1)), lept_get_string_length(lept_get_array_element(a, 1)));
+    EXPECT_EQ_STRING("abc", lept_get_string(lept_get_object_value(&v, 1)), lept_get_string_length(lept_get_object_value(&v, 1)));
+
+    /* values borrowed from the buffer can still be replaced and freed */
+    lept_set_string(lept_get_array_element(a, 0), "Hi", 2);
+    EXPECT_EQ_STRING("Hi", lept_get_string(lept_get_array_element(a, 0)), lept_get_string_length(lept_get_array_element(a, 0)));
+    lept_free(&v);
+}
+
 #define TEST_PARSE_ERROR(error, json)\
     do {\
         lept_value v;\
@@ -233,6 +498,7 @@ static void test_parse_object() {
         v.type = LEPT_FALSE;\
         EXPECT_EQ_INT(error, lept_parse(&v, json));\
         EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));\
+        EXPECT_EQ_INT(error, lept_validate(json, strlen(json), NULL));\
         lept_free(&v);\
     } while(0)
 
@@ -272,11 +538,15 @@ static void test_parse_root_not_singular() {
 static void test_parse_number_too_big() {
     TEST_PARSE_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "1e309");
     TEST_PARSE_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "-1e309");
+    TEST_PARSE_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "1.7976931348623159e308");
+    TEST_PARSE_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "1e99999999999999999999");
+    TEST_PARSE_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "-17976931348623159000000000000000000000000e268");
 }
 
 static void test_parse_miss_quotation_mark() {
     TEST_PARSE_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, "\"");
     TEST_PARSE_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, "\"abc");
+    TEST_PARSE_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, "\"0123456789abcdefghijklmnopqrstuvwxyz");
 }
 
 static void test_parse_invalid_string_escape() {
@@ -289,6 +559,7 @@ static void test_parse_invalid_string_escape() {
 static void test_parse_invalid_string_char() {
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_STRING_CHAR, "\"\x01\"");
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_STRING_CHAR, "\"\x1F\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_STRING_CHAR, "\"0123456789abcdefghijklmnopqrstuvwxyz\x01\"");
 }
 
 static void test_parse_invalid_unicode_hex() {
@@ -345,14 +616,814 @@ static void test_parse_miss_comma_or_curly_bracket() {
     TEST_PARSE_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":{}");
 }
 
+/* A JSON object of keys "k0".."k<n-1>" with values 0..n-1, then "k0" again (-1). */
+static char* object_of(size_t n) {
+    char* json = (char*)malloc(32 + 16 * n), *p = json;
+    size_t i;
+    *p++ = '{';
+    for (i = 0; i < n; i++)
+        p += sprintf(p, "\"k%u\":%u,", (unsigned)i, (unsigned)i);
+    strcpy(p, "\"k0\":-1}");
+    return json;
+}
+
+/* n copies of open followed by n copies of close */
+static char* nested(const char* open, const char* close, size_t n) {
+    size_t lo = strlen(open), lc = strlen(close), i;
+    char* json = (char*)malloc(n * (lo + lc) + 1), *p = json;
+    for (i = 0; i < n; i++, p += lo)
+        memcpy(p, open, lo);
+    for (i = 0; i < n; i++, p += lc)
+        memcpy(p, close, lc);
+    *p = '\0';
+    return json;
+}
+
+static void test_parse_depth_exceeded() {
+    lept_value v;
+    lept_value* e;
+    char* json;
+    size_t i;
+
+    json = nested("[", "]", LEPT_PARSE_MAX_DEPTH);
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    for (e = &v, i = 1; lept_get_type(e) == LEPT_ARRAY && lept_get_array_size(e) == 1; i++)
+        e = lept_get_array_element(e, 0);
+    EXPECT_EQ_SIZE_T(LEPT_PARSE_MAX_DEPTH, i);
+    EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(e));
+    EXPECT_EQ_SIZE_T(0, lept_get_array_size(e));
+    lept_free(&v);
+    free(json);
+
+    json = nested("[", "]", LEPT_PARSE_MAX_DEPTH + 1);
+    TEST_PARSE_ERROR(LEPT_PARSE_DEPTH_EXCEEDED, json);
+    free(json);
+
+    json = nested("{\"a\":[", "]}", LEPT_PARSE_MAX_DEPTH / 2);
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    lept_free(&v);
+    free(json);
+
+    json = nested("{\"a\":[1,\"b\",", "]}", LEPT_PARSE_MAX_DEPTH / 2 + 1);
+    TEST_PARSE_ERROR(LEPT_PARSE_DEPTH_EXCEEDED, json);
+    free(json);
+
+    /* must fail without exhausting the C stack */
+    json = nested("[", "", 100000);
+    TEST_PARSE_ERROR(LEPT_PARSE_DEPTH_EXCEEDED, json);
+    free(json);
+}
+
+/* Parses "<pad ASCII bytes><s>" as a string, with UTF-8 validation. */
+static int utf8_parse(const char* s, size_t len, size_t pad) {
+    char json[64];
+    lept_value v;
+    int ret;
+    json[0] = '"';
+    memset(json + 1, 'a', pad);
+    memcpy(json + 1 + pad, s, len);
+    json[1 + pad + len] = '"';
+    lept_init(&v);
+    ret = lept_parse_ex(&v, json, pad + len + 2, LEPT_PARSE_FLAG_VALIDATE_UTF8);
+    lept_free(&v);
+    return ret;
+}
+
+/* Well-formed UTF-8 by decoding: shortest form, no surrogate, at most U+10FFFF. */
+static int utf8_reference(const unsigned char* s, size_t len) {
+    size_t i = 0, n, k;
+    unsigned u;
+    while (i < len) {
+        if (s[i] < 0x80) { i++; continue; }
+        else if ((s[i] & 0xE0) == 0xC0) { n = 2; u = s[i] & 0x1F; }
+        else if ((s[i] & 0xF0) == 0xE0) { n = 3; u = s[i] & 0x0F; }
+        else if ((s[i] & 0xF8) == 0xF0) { n = 4; u = s[i] & 0x07; }
+        else return 0;
+        if (i + n > len)
+            return 0;
+        for (k = 1; k < n; k++) {
+            if ((s[i + k] & 0xC0) != 0x80)
+                return 0;
+            u = u << 6 | (s[i + k] & 0x3F);
+        }
+        if (u < (n == 2 ? 0x80u : n == 3 ? 0x800u : 0x10000u) || u > 0x10FFFF || (u >= 0xD800 && u <= 0xDFFF))
+            return 0;
+        i += n;
+    }
+    return 1;
+}
+
+static void test_parse_invalid_utf8() {
+    static const char* valid[] = {
+        "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF",
+        "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9D\x84\x9E"
+    };
+    static const char* invalid[] = {
+        "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xC2", "\xC2\x41", "\xC2\x80\x80", "\xE1\x80", "\xE1\x80\x80\x80",
+        "\xE0\x80\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xF1\x80\x80", "\xF0\x80\x80\x80",
+        "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80", "\xFF", "\xFE"
+    };
+    static const unsigned char bytes[] = {
+        0x41, 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF,
+        0xE0, 0xE1, 0xED, 0xEF, 0xF0, 0xF1, 0xF4, 0xF5, 0xFF
+    };
+    const size_t nb = sizeof(bytes);
+    unsigned char s[4];
+    size_t i, pad, mismatches = 0;
+    lept_value v;
+
+    /* each case at every position in, and across, 16- and 32-byte blocks */
+    for (pad = 0; pad <= 40; pad++) {
+        for (i = 0; i < sizeof(valid) / sizeof(valid[0]); i++)
+            EXPECT_EQ_INT(LEPT_PARSE_OK, utf8_parse(valid[i], strlen(valid[i]), pad));
+        for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+            EXPECT_EQ_INT(LEPT_PARSE_INVALID_UTF8, utf8_parse(invalid[i], strlen(invalid[i]), pad));
+    }
+
+    /* every 4-byte sequence over bytes at the edges of the ranges, against a decoder */
+    for (i = 0; i < nb * nb * nb * nb; i++) {
+        s[0] = bytes[i % nb];
+        s[1] = bytes[i / nb % nb];
+        s[2] = bytes[i / nb / nb % nb];
+        s[3] = bytes[i / nb / nb / nb];
+        if ((utf8_parse((const char*)s, 4, i % 33) == LEPT_PARSE_OK) != utf8_reference(s, 4))
+            mismatches++;
+    }
+    EXPECT_EQ_SIZE_T(0, mismatches);
+
+    /* a character cannot be split by an escape; escaped surrogates are checked as before */
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UTF8, utf8_parse("\xC3\\n\xA9", 5, 0));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, utf8_parse("\\uD834\\uDD1E\xC3\xA9", 14, 0));
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UTF8, lept_parse_ex(&v, "{\"\xC0\xAF\":1}", 8, LEPT_PARSE_FLAG_VALIDATE_UTF8));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+
+    /* without the flag bytes pass through unchecked */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, "\"\xFF\xC0\"", 4, 0));
+    EXPECT_EQ_STRING("\xFF\xC0", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+}
+
+/* Records the events as text, e.g. [n,b1,i-2,d0.5,],{ka:s"b",}, */
+typedef struct {
+    char buf[256];
+    size_t len;
+    int stop;   /* abort with LEPT_PARSE_INVALID_VALUE at this event, if > 0 */
+}sax_log;
+
+static void sax_append(sax_log* log, const char* s, size_t len) {
+    if (log->len + len < sizeof(log->buf)) {
+        memcpy(log->buf + log->len, s, len);
+        log->buf[log->len += len] = '\0';
+    }
+}
+
+/* Logs one event. */
+static int sax_put(void* ctx, const char* s, size_t len) {
+    sax_log* log = (sax_log*)ctx;
+    sax_append(log, s, len);
+    return --log->stop == 0 ? LEPT_PARSE_INVALID_VALUE : LEPT_PARSE_OK;
+}
+
+static int sax_null(void* ctx) { return sax_put(ctx, "n,", 2); }
+static int sax_boolean(void* ctx, int b) { return sax_put(ctx, b ? "b1," : "b0,", 3); }
+static int sax_start_object(void* ctx) { return sax_put(ctx, "{", 1); }
+static int sax_end_object(void* ctx) { return sax_put(ctx, "},", 2); }
+static int sax_start_array(void* ctx) { return sax_put(ctx, "[", 1); }
+static int sax_end_array(void* ctx) { return sax_put(ctx, "],", 2); }
+
+static int sax_number(void* ctx, double n) {
+    char s[32];
+    return sax_put(ctx, s, sprintf(s, "d%g,", n));
+}
+
+static int sax_int64(void* ctx, int64_t i) {
+    char s[32];
+    return sax_put(ctx, s, sprintf(s, "i%ld,", (long)i));
+}
+
+static int sax_string(void* ctx, const char* str, size_t len) {
+    sax_append((sax_log*)ctx, "s\"", 2);
+    sax_append((sax_log*)ctx, str, len);
+    return sax_put(ctx, "\",", 2);
+}
+
+static int sax_key(void* ctx, const char* k, size_t klen) {
+    sax_append((sax_log*)ctx, "k", 1);
+    sax_append((sax_log*)ctx, k, klen);
+    return sax_put(ctx, ":", 1);
+}
+
+static const lept_handler sax_handler = {
+    sax_null, sax_boolean, sax_number, sax_int64, NULL, sax_string,
+    sax_start_object, sax_key, sax_end_object, sax_start_array, sax_end_array
+};
+
+#define TEST_SAX(expect, json)\
+    do {\
+        sax_log log;\
+        log.len = 0;\
+        log.buf[0] = '\0';\
+        log.stop = 0;\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax(&sax_handler, &log, json));\
+        EXPECT_EQ_STRING(expect, log.buf, log.len);\
+    } while(0)
+
+/* lept_parse_sax() must fail exactly as lept_parse() does */
+#define TEST_SAX_ERROR(json)\
+    do {\
+        sax_log log;\
+        lept_value v;\
+        log.len = 0;\
+        log.stop = 0;\
+        lept_init(&v);\
+        EXPECT_EQ_INT(lept_parse(&v, json), lept_parse_sax(&sax_handler, &log, json));\
+        lept_free(&v);\
+    } while(0)
+
+static void test_parse_sax() {
+    static const lept_handler empty = { NULL };
+    sax_log log;
+    char* json;
+
+    TEST_SAX("n,", " null ");
+    TEST_SAX("[b1,b0,i-2,d0.5,d1e+300,d1.84467e+19,],", "[true,false,-2,0.5,1e300,18446744073709551615]");
+    TEST_SAX("s\"a\"b\",", "\"a\\\"b\"");
+    TEST_SAX("{ka:[],kb:{},k:s\"\",},", "{ \"a\" : [ ] , \"b\" : { } , \"\" : \"\" }");
+    TEST_SAX("[[{kx:[n,],},],],", "[[{\"x\":[null]}]]");
+
+    TEST_SAX_ERROR("");
+    TEST_SAX_ERROR("nul");
+    TEST_SAX_ERROR("[1,]");
+    TEST_SAX_ERROR("[1 2");
+    TEST_SAX_ERROR("{\"a\":1,}");
+    TEST_SAX_ERROR("{\"a\" 1}");
+    TEST_SAX_ERROR("{1:1}");
+    TEST_SAX_ERROR("{\"a\":1 \"b\"}");
+    TEST_SAX_ERROR("[\"\\x\"]");
+    TEST_SAX_ERROR("[1e309]");
+    TEST_SAX_ERROR("[] x");
+    json = nested("[", "]", LEPT_PARSE_MAX_DEPTH);
+    TEST_SAX_ERROR(json);
+    free(json);
+    json = nested("{\"a\":[", "]}", LEPT_PARSE_MAX_DEPTH / 2 + 1);
+    TEST_SAX_ERROR(json);
+    free(json);
+
+    /* every callback may be NULL */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax(&empty, NULL, "{\"a\":[1,\"b\",true,null,{}]}"));
+
+    /* a callback's error stops the parse and is returned */
+    log.len = 0;
+    log.stop = 4;
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_sax(&sax_handler, &log, "{\"a\":[1,2,3]}"));
+    EXPECT_EQ_STRING("{ka:[i1,", log.buf, log.len);
+}
+
+/* Feeds json to p in two chunks split at `split`, or byte by byte if split is len + 1. */
+static int push_parse(lept_parser* p, lept_value* v, const char* json, size_t len, size_t split) {
+    size_t i;
+    if (split <= len) {
+        lept_parser_feed(p, json, split);
+        lept_parser_feed(p, json + split, len - split);
+    }
+    else
+        for (i = 0; i < len; i++)
+            lept_parser_feed(p, json + i, 1);
+    return lept_parser_finish(p, v);
+}
+
+#define TEST_PARSE_PUSH(p, json, len, split)\
+    do {\
+        lept_value v1, v2;\
+        int ret;\
+        lept_init(&v1);\
+        lept_init(&v2);\
+        ret = lept_parse_n(&v1, json, len);\
+        EXPECT_EQ_INT(ret, push_parse(p, &v2, json, len, split));\
+        if (ret == LEPT_PARSE_OK) {\
+            char* json1 = lept_stringify(&v1, NULL);\
+            char* json2 = lept_stringify(&v2, NULL);\
+            EXPECT_EQ_BASE(strcmp(json1, json2) == 0, json1, json2, "%s");\
+            free(json1);\
+            free(json2);\
+        }\
+        lept_free(&v1);\
+        lept_free(&v2);\
+    } while(0)
+
+static void test_parse_push() {
+    static const char* inputs[] = {
+        " { \"a\" : [ 1 , 2.5e3 , -0 , true , false , null ] , \"b\" : { } , \"c\" : [ ] } ",
+        "{\"k\\u0065y\":\"\\uD834\\uDD1E\\n\\\\\\\"\",\"\":[[],{}],\"n\":-12345678901234567890.5e-3}",
+        "18446744073709551615", "-9223372036854775808", "\"\\\\\"", "\"\"", "[\"\",\"\\\"\"]",
+        "", " ", "  1  ", " 1 2", "[1x]", "[1 x]", "truex", "[ \"a\" x]", "[ 1 , ]", "{ \"a\" : 1 , }",
+        "{ \"a\" 1 }", "{ 1 : 1 }", "[ \"abc ]", "[ \"a\\q\" ]", "[ tru e ]", "[ nul ]", "[ -", "[ 1e",
+        "[ 1 }", "{ \"a\" : 1 ]", "[ [ ] ", "{", "{\"a\"", "{\"a\":", "{\"a\":1,", "[1,", "\"\\u12", "\"\\uD800\"",
+        "\"\\uD800\\u", "[1e309]", "\"a\x01\"", "[\"\\\"\" ]", " \" \\\" \" ]"
+    };
+    lept_parser* p = lept_parser_create();
+    lept_value v;
+    char* json;
+    size_t i, k, len;
+    for (i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        len = strlen(inputs[i]);
+        for (k = 0; k <= len + 1; k++)
+            TEST_PARSE_PUSH(p, inputs[i], len, k);
+    }
+
+    json = nested("[", "]", LEPT_PARSE_MAX_DEPTH + 1);
+    TEST_PARSE_PUSH(p, json, strlen(json), LEPT_PARSE_MAX_DEPTH / 2);
+    free(json);
+
+    /* an error is reported as soon as it is seen */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "[{\"a\":[1,", 9));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parser_feed(p, "]", 1));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parser_feed(p, "2]}]", 4));
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parser_finish(p, &v));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+
+    /* a parser left mid-text frees what it has built */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "{\"a\":[\"b\",{\"c\":\"d", 17));
+    lept_parser_free(p);
+    p = lept_parser_create();
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "[1] ", 4));
+    lept_parser_free(p);
+}
+
+static void test_parse_reuse() {
+    static const char* inputs[] = {
+        "{\"a\":[1,\"b\",null],\"c\":{\"d\":true}}", "[]", "\"x\"", "[1,", "{\"a\" 1}", "  -12.5e3  ", "[[[]]] 1"
+    };
+    lept_parser* p = lept_parser_create();
+    lept_value v1, v2;
+    char* json, *json1, *json2;
+    size_t i, keep;
+    int ret;
+
+    for (i = 0; i < sizeof(inputs) / sizeof(inputs[0]) * 3; i++) {
+        const char* s = inputs[i % (sizeof(inputs) / sizeof(inputs[0]))];
+        ret = lept_parse(&v1, s);
+        EXPECT_EQ_INT(ret, lept_parser_parse(p, &v2, s, strlen(s), i % 2 ? LEPT_PARSE_FLAG_INDEXED : 0));
+        if (ret == LEPT_PARSE_OK) {
+            EXPECT_TRUE(lept_is_equal(&v1, &v2));
+            lept_free(&v1);
+        }
+        else
+            EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v2));
+        lept_free(&v2);
+    }
+
+    /* one large text grows the stack past the keep size, then parses go on as before */
+    for (keep = 0; keep <= 4096; keep += 4096) {
+        lept_parser_set_keep_size(p, keep);
+        json = nested("[\"abcdefghijklmnopqrstuvwxyz\",", "]", LEPT_PARSE_MAX_DEPTH);
+        json1 = strstr(json, "]");
+        memmove(json1 - 1, json1, strlen(json1) + 1); /* drop the innermost ',' */
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(p, &v1, json, strlen(json), 0));
+        json2 = lept_stringify(&v1, NULL);
+        EXPECT_EQ_BASE(strcmp(json, json2) == 0, json, json2, "%s");
+        lept_free(&v1);
+        free(json2);
+        free(json);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(p, &v1, "[1,[2]]", 7, 0));
+        EXPECT_EQ_SIZE_T(2, lept_get_array_size(&v1));
+        lept_free(&v1);
+    }
+
+    /* whole and pushed texts on one parser */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "{\"a\":", 5));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "[2]}", 4));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_finish(p, &v1));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(p, &v2, "{\"a\":[2]}", 9, 0));
+    EXPECT_TRUE(lept_is_equal(&v1, &v2));
+    lept_free(&v1);
+    lept_free(&v2);
+    lept_parser_free(p);
+}
+
+static void test_parse_document() {
+    const char* json = "{\"a\":[1,\"bc\",null,{\"d\":[]}],\"e\":\"f\",\"g\":{\"h\":true}}";
+    lept_document* d = lept_document_create();
+    lept_value v, *root, *a;
+    char* big, *s;
+    size_t i, length;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    for (i = 0; i < 3; i++) {
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, json, strlen(json), i == 2 ? LEPT_PARSE_FLAG_INDEXED : 0));
+        EXPECT_TRUE(lept_is_equal(&v, lept_document_root(d)));
+    }
+    lept_free(&v);
+
+    /* values in the arena can be changed, grown and replaced */
+    root = lept_document_root(d);
+    EXPECT_TRUE(lept_find_object_value(root, "e", 1)->flags & LEPT_FLAG_INLINE);
+    a = lept_find_object_value(root, "a", 1);
+    lept_set_string(lept_get_array_element(a, 1), "xyz", 3);
+    lept_set_number(lept_pushback_array_element(a), 5.0);
+    lept_set_string(lept_pushback_array_element(a), "long", 4);
+    lept_popback_array_element(a);
+    lept_set_array(lept_find_object_value(root, "e", 1), 0);
+    lept_set_boolean(lept_pushback_array_element(lept_find_object_value(root, "e", 1)), 0);
+    lept_move(&v, lept_find_object_value(root, "g", 1));
+    lept_free(&v);
+    s = lept_stringify(root, &length);
+    EXPECT_EQ_STRING("{\"a\":[1,\"xyz\",null,{\"d\":[]},5],\"e\":[false],\"g\":null}", s, length);
+    free(s);
+    lept_document_reset(d);
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_document_root(d)));
+
+    /* a failed parse leaves null and the document reusable */
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_document_parse(d, "{\"a\":[\"b\"] 1}", 14, 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_document_root(d)));
+
+    /* a text spanning many arena blocks, then a small one in the merged block */
+    big = nested("{\"abcdefghijklmnopqrstuvwxyz\":[\"0123456789\",", "]}", LEPT_PARSE_MAX_DEPTH / 2);
+    s = strstr(big, "]");
+    memmove(s - 1, s, strlen(s) + 1); /* drop the innermost ',' */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, big, strlen(big), 0));
+    s = lept_stringify(lept_document_root(d), NULL);
+    EXPECT_EQ_BASE(strcmp(big, s) == 0, big, s, "%s");
+    free(s);
+    free(big);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, "[\"x\",{\"y\":2}]", 13, 0));
+    EXPECT_EQ_SIZE_T(2, lept_get_array_size(lept_document_root(d)));
+    lept_document_free(d);
+
+    /* freed with its tree, changed or not */
+    d = lept_document_create();
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, json, strlen(json), 0));
+    lept_set_string(lept_find_object_value(lept_document_root(d), "e", 1), "owned", 5);
+    lept_document_free(d);
+
+    /* heap memory set in the tree is freed by the next parse's reset */
+    d = lept_document_create();
+    for (i = 0; i < 6; i++) {
+        const char* heap = "too long to be stored inline";
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, json, strlen(json), 0));
+        a = lept_find_object_value(lept_document_root(d), "a", 1);
+        switch (i) {
+            case 0: break;
+            case 1: lept_init(lept_get_array_element(a, 2)); lept_set_string(lept_get_array_element(a, 2), heap, strlen(heap)); break;
+            case 2: EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(lept_get_array_element(a, 0), "[[]]")); break;
+            case 3: lept_set_array(&v, 1); lept_swap(&v, lept_get_array_element(a, 2)); break;
+            case 4: lept_reserve_array(a, 100); break;
+            case 5: lept_set_string(&v, heap, strlen(heap)); lept_move(lept_document_root(d), &v); break;
+        }
+    }
+    lept_document_free(d);
+
+    /* a tree only read since the parse is dropped with the arena */
+    d = lept_document_create();
+    for (i = 0; i < 3; i++) {
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, json, strlen(json), 0));
+        EXPECT_EQ_SIZE_T(4, lept_get_array_size(lept_find_object_value(lept_document_root(d), "a", 1)));
+        lept_document_reset_unchanged(d);
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_document_root(d)));
+    }
+    lept_document_free(d);
+}
+
+static void test_parse_intern_keys() {
+    const char* json = "[{\"id\":1,\"name\":\"a\"},{\"name\":\"b\",\"id\":2},{\"id\":3,\"tags\":{\"id\":\"x\"}}]";
+    lept_document* d = lept_document_create();
+    lept_value v, *root;
+    const char* id, *name;
+    char* big, *p;
+    size_t i;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    EXPECT_TRUE(lept_document_find_key(d, "id", 2) == NULL);
+    for (i = 0; i < 3; i++) {
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, json, strlen(json),
+            LEPT_PARSE_FLAG_INTERN_KEYS | (i == 2 ? LEPT_PARSE_FLAG_INDEXED : 0)));
+        root = lept_document_root(d);
+        EXPECT_TRUE(lept_is_equal(&v, root));
+        /* one copy of each key, the same from one parse to the next */
+        if (i == 0) {
+            id = lept_document_find_key(d, "id", 2);
+            name = lept_document_find_key(d, "name", 4);
+        }
+        EXPECT_TRUE(id != NULL && name != NULL && id != name);
+        EXPECT_TRUE(lept_document_find_key(d, "id", 2) == id);
+        EXPECT_TRUE(lept_get_object_key(lept_get_array_element(root, 0), 0) == id);
+        EXPECT_TRUE(lept_get_object_key(lept_get_array_element(root, 1), 1) == id);
+        EXPECT_TRUE(lept_get_object_key(lept_get_array_element(root, 1), 0) == name);
+        EXPECT_TRUE(lept_get_object_key(lept_get_object_value(lept_get_array_element(root, 2), 1), 0) == id);
+        EXPECT_EQ_SIZE_T(1, lept_find_object_index(lept_get_array_element(root, 1), id, 2));
+        EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(lept_get_array_element(root, 1), "i", 1));
+        EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(lept_get_array_element(root, 1), id, 1));
+        EXPECT_TRUE(lept_document_find_key(d, "idx", 3) == NULL);
+        EXPECT_TRUE(lept_document_find_key(d, "i", 1) == NULL);
+    }
+    lept_free(&v);
+
+    /* without the flag keys are copied; lookups by an interned key still work */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, json, strlen(json), 0));
+    root = lept_document_root(d);
+    EXPECT_TRUE(lept_get_object_key(lept_get_array_element(root, 0), 0) != id);
+    EXPECT_EQ_SIZE_T(1, lept_find_object_index(lept_get_array_element(root, 1), id, 2));
+
+    /* keys that are values of no schema are not kept for later texts */
+    big = (char*)malloc(3 + 16 * 5000);
+    p = big;
+    *p++ = '{';
+    for (i = 0; i < 5000; i++)
+        p += sprintf(p, "%s\"k%u\":%u", i ? "," : "", (unsigned)i, (unsigned)i);
+    *p++ = '}';
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, big, (size_t)(p - big), LEPT_PARSE_FLAG_INTERN_KEYS));
+    EXPECT_EQ_SIZE_T(5000, lept_get_object_size(lept_document_root(d)));
+    EXPECT_TRUE(lept_document_find_key(d, "k4999", 5) == lept_get_object_key(lept_document_root(d), 4999));
+    EXPECT_EQ_DOUBLE(4999.0, lept_get_number(lept_find_object_value(lept_document_root(d), "k4999", 5)));
+    EXPECT_TRUE(lept_document_find_key(d, "id", 2) == id);
+    lept_document_reset(d);
+    EXPECT_TRUE(lept_document_find_key(d, "k4999", 5) == NULL);
+    EXPECT_TRUE(lept_document_find_key(d, "id", 2) == NULL);
+    free(big);
+    lept_document_free(d);
+}
+
+static int parse_duplicates(lept_value* v, const char* json, unsigned flags) {
+    lept_free(v);
+    return lept_parse_ex(v, json, strlen(json), flags);
+}
+
+#define TEST_DUPLICATES(expect, json, flags)\
+    do {\
+        lept_value v;\
+        char* s;\
+        size_t i;\
+        lept_init(&v);\
+        for (i = 0; i < 2; i++) {\
+            EXPECT_EQ_INT(LEPT_PARSE_OK, parse_duplicates(&v, json, (flags) | (i ? LEPT_PARSE_FLAG_INDEXED : 0)));\
+            s = lept_stringify(&v, NULL);\
+            EXPECT_EQ_BASE(strcmp(expect, s) == 0, expect, s, "%s");\
+            free(s);\
+        }\
+        lept_free(&v);\
+    } while(0)
+
+static void test_parse_duplicates() {
+    const char* json = "{\"a\":1,\"b\":\"two\",\"a\":[3],\"c\":{\"d\":4,\"d\":\"five\"},\"b\":{\"x\":6},\"a\":null}";
+    lept_document* d = lept_document_create();
+    lept_value v;
+    char* big;
+    size_t i, n;
+
+    TEST_DUPLICATES(json, json, 0);
+    TEST_DUPLICATES("{\"a\":1,\"b\":\"two\",\"c\":{\"d\":4}}", json, LEPT_PARSE_FLAG_DUPLICATES_FIRST);
+    TEST_DUPLICATES("{\"a\":null,\"b\":{\"x\":6},\"c\":{\"d\":\"five\"}}", json, LEPT_PARSE_FLAG_DUPLICATES_LAST);
+    TEST_DUPLICATES("[{},{\"a\":1},{\"a\":1,\"A\":2,\"a \":3}]", "[{},{\"a\":1},{\"a\":1,\"A\":2,\"a \":3}]", LEPT_PARSE_FLAG_DUPLICATES_REJECT);
+    TEST_DUPLICATES("{\"\":[1]}", "{\"\":[],\"\":[1]}", LEPT_PARSE_FLAG_DUPLICATES_LAST);
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_DUPLICATE_KEY, parse_duplicates(&v, json, LEPT_PARSE_FLAG_DUPLICATES_REJECT));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_DUPLICATE_KEY, parse_duplicates(&v, "[{\"a\":{\"b\":[\"x\",{}],\"b\":0}}]", LEPT_PARSE_FLAG_DUPLICATES_REJECT | LEPT_PARSE_FLAG_INDEXED));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+
+    /* large objects: "k0" comes again last */
+    for (n = 10; n <= 10000; n *= 10) {
+        big = object_of(n);
+        EXPECT_EQ_INT(LEPT_PARSE_DUPLICATE_KEY, parse_duplicates(&v, big, LEPT_PARSE_FLAG_DUPLICATES_REJECT));
+        for (i = 0; i < 2; i++) {
+            EXPECT_EQ_INT(LEPT_PARSE_OK, parse_duplicates(&v, big, i ? LEPT_PARSE_FLAG_DUPLICATES_LAST : LEPT_PARSE_FLAG_DUPLICATES_FIRST));
+            EXPECT_EQ_SIZE_T(n, lept_get_object_size(&v));
+            EXPECT_EQ_DOUBLE(i ? -1.0 : 0.0, lept_get_number(lept_get_object_value(&v, 0)));
+            EXPECT_EQ_DOUBLE((double)(n - 1), lept_get_number(lept_get_object_value(&v, n - 1)));
+        }
+        /* in a document with interned keys */
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, big, strlen(big), LEPT_PARSE_FLAG_INTERN_KEYS | LEPT_PARSE_FLAG_DUPLICATES_LAST));
+        EXPECT_EQ_SIZE_T(n, lept_get_object_size(lept_document_root(d)));
+        EXPECT_EQ_DOUBLE(-1.0, lept_get_number(lept_find_object_value(lept_document_root(d), "k0", 2)));
+        EXPECT_EQ_INT(LEPT_PARSE_DUPLICATE_KEY, lept_document_parse(d, big, strlen(big), LEPT_PARSE_FLAG_DUPLICATES_REJECT));
+        free(big);
+    }
+    lept_free(&v);
+    lept_document_free(d);
+}
+
+static void test_parse_stream() {
+    const char* json = "1\n[2]\n{\"a\":3}\r\n\n  \"x\"[][4]true null 5";
+    static const size_t offsets[] = { 0, 2, 6, 18, 21, 23, 26, 31, 36 };
+    lept_stream s;
+    lept_value v;
+    char* str;
+    size_t i;
+
+    lept_stream_init(&s, json, strlen(json));
+    for (i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_next(&s, &v));
+        EXPECT_EQ_SIZE_T(offsets[i], s.offset);
+        lept_free(&v);
+    }
+    EXPECT_EQ_INT(LEPT_STREAM_END, lept_stream_next(&s, &v));
+    EXPECT_EQ_INT(LEPT_STREAM_END, lept_stream_next(&s, &v));
+    lept_stream_free(&s);
+
+    lept_stream_init(&s, "{\"a\":[\"b\"]}\n[\"c\",\n\"d\"]\n", 22);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_next(&s, &v));
+    EXPECT_EQ_STRING("b", lept_get_string(lept_get_array_element(lept_find_object_value(&v, "a", 1), 0)), 1);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_next(&s, &v));
+    str = lept_stringify(&v, NULL);
+    EXPECT_EQ_STRING("[\"c\",\"d\"]", str, strlen(str));
+    free(str);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_STREAM_END, lept_stream_next(&s, &v));
+    lept_stream_free(&s);
+
+    lept_stream_init(&s, " \n ", 3);
+    EXPECT_EQ_INT(LEPT_STREAM_END, lept_stream_next(&s, &v));
+    lept_stream_free(&s);
+
+    /* an error ends the stream; offset is where the bad document starts */
+    lept_stream_init(&s, "1\n[2,\n3\n", 8);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_next(&s, &v));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_stream_next(&s, &v));
+    EXPECT_EQ_SIZE_T(2, s.offset);
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_stream_next(&s, &v));
+    lept_stream_free(&s);
+}
+
+typedef struct {
+    const char* json;
+    size_t count, stop;     /* lines seen; stop with 7 at this count, if > 0 */
+    size_t last;            /* offset of the previous line */
+}lines_check;
+
+/* Checks each line against lept_parse_n() on that line alone. */
+static int lines_check_line(void* ctx, size_t offset, int ret, lept_value* v) {
+    lines_check* check = (lines_check*)ctx;
+    const char* eol = strchr(check->json + offset, '\n');
+    size_t len = eol != NULL ? (size_t)(eol - check->json) - offset : strlen(check->json + offset);
+    lept_value e;
+    lept_init(&e);
+    EXPECT_EQ_INT(lept_parse_n(&e, check->json + offset, len), ret);
+    EXPECT_TRUE(check->count == 0 || offset > check->last);
+    EXPECT_TRUE(lept_is_equal(&e, v));
+    lept_free(&e);
+    check->last = offset;
+    return ++check->count == check->stop ? 7 : 0;
+}
+
+static void test_parse_lines() {
+    static const char* lines[] = { "{\"id\":1,\"tags\":[\"a\",\"b\"]}", "  [1, 2.5, null]  ", "", "  \t", "\"s\"", "[1,", "1 2", "{\"a\":{}}" };
+    static const unsigned threads[] = { 1, 2, 4, 7 };
+    lines_check check;
+    char* json = (char*)malloc(1200 * 32), *p = json;
+    size_t i, nonblank = 0;
+    for (i = 0; i < 1200; i++) {
+        const char* line = lines[i * 7 % (sizeof(lines) / sizeof(lines[0]))];
+        nonblank += strspn(line, " \t") != strlen(line);
+        p += sprintf(p, "%s%s", line, i % 5 == 0 ? "\r\n" : "\n");
+    }
+    p[-1] = ' ';    /* no newline after the last line */
+    for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+        check.json = json;
+        check.count = check.stop = 0;
+        EXPECT_EQ_INT(0, lept_parse_lines(json, p - json, threads[i], lines_check_line, &check));
+        EXPECT_EQ_SIZE_T(nonblank, check.count);
+        check.count = 0;
+        check.stop = 400;
+        EXPECT_EQ_INT(7, lept_parse_lines(json, p - json, threads[i], lines_check_line, &check));
+        EXPECT_EQ_SIZE_T(400, check.count);
+    }
+    check.count = 0;
+    EXPECT_EQ_INT(0, lept_parse_lines(NULL, 0, 4, lines_check_line, &check));
+    EXPECT_EQ_INT(0, lept_parse_lines("\n\n  \n", 5, 4, lines_check_line, &check));
+    EXPECT_EQ_SIZE_T(0, check.count);
+    free(json);
+}
+
+#define TEST_VALIDATE(error, offset, json)\
+    do {\
+        size_t err_offset = (size_t)-1;\
+        EXPECT_EQ_INT(error, lept_validate(json, strlen(json), &err_offset));\
+        EXPECT_EQ_SIZE_T(offset, err_offset);\
+    } while(0)
+
+static void test_parse_validate() {
+    char* json;
+    size_t i, len, err_offset = 0;
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(" { \"a\" : [ 1 , 2.5e3 , true , null , \"\\uD834\\uDD1E\" ] , \"b\" : { } } ", 68, &err_offset));
+    EXPECT_EQ_SIZE_T(0, err_offset);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate("[1]garbage", 3, NULL));
+
+    /* the offset is where the failing token starts */
+    TEST_VALIDATE(LEPT_PARSE_EXPECT_VALUE, 2, "  ");
+    TEST_VALIDATE(LEPT_PARSE_ROOT_NOT_SINGULAR, 4, "[1] 2");
+    TEST_VALIDATE(LEPT_PARSE_INVALID_VALUE, 5, "[1, tru]");
+    TEST_VALIDATE(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, 3, "[1 2]");
+    TEST_VALIDATE(LEPT_PARSE_MISS_KEY, 9, "{\"a\":1 , 2}");
+    TEST_VALIDATE(LEPT_PARSE_MISS_COLON, 5, "{\"a\" 1}");
+    TEST_VALIDATE(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, 6, "{\"a\":1]");
+    TEST_VALIDATE(LEPT_PARSE_INVALID_STRING_ESCAPE, 1, "[\"\\x\"]");
+    TEST_VALIDATE(LEPT_PARSE_MISS_QUOTATION_MARK, 5, "{\"a\":\"b");
+    TEST_VALIDATE(LEPT_PARSE_NUMBER_TOO_BIG, 1, "[1e309]");
+
+    /* numbers the decimal slow path has to round, ending the input or not */
+    json = (char*)malloc(130);
+    memset(json, '1', 128);
+    memcpy(json + 125, "e-3", 3);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(json, 128, NULL));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(json + 100, 28, NULL));
+    memcpy(json + 128, " ]", 2);
+    json[0] = '[';
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(json, 130, NULL));
+    json[123] = 'e';
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_validate(json, 130, NULL));
+    free(json);
+
+    /* objects and arrays alternating, as deep as allowed */
+    json = (char*)malloc(LEPT_PARSE_MAX_DEPTH / 2 * 8 + 2);
+    for (len = 0, i = 0; i < LEPT_PARSE_MAX_DEPTH / 2; i++, len += 6)
+        memcpy(json + len, "[{\"a\":", 6);
+    json[len++] = '1';
+    for (i = 0; i < LEPT_PARSE_MAX_DEPTH / 2; i++, len += 2)
+        memcpy(json + len, "}]", 2);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(json, len, NULL));
+    json[len - 2] = ']';
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_validate(json, len, NULL));
+    free(json);
+    json = nested("[", "]", LEPT_PARSE_MAX_DEPTH + 1);
+    TEST_VALIDATE(LEPT_PARSE_DEPTH_EXCEEDED, LEPT_PARSE_MAX_DEPTH, json);
+    free(json);
+}
+
+static int write_file(const char* path, const char* data, size_t len) {
+    FILE* f = fopen(path, "wb");
+    if (f == NULL)
+        return 0;
+    fwrite(data, 1, len, f);
+    fclose(f);
+    return 1;
+}
+
+static void test_parse_file() {
+    const char* path = "leptjson_test.json";
+    lept_value v;
+    char* json;
+    size_t len;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_FILE_IO_ERROR, lept_parse_file(&v, "leptjson_missing.json", 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    if (!write_file(path, "{\"a\":[1,\"b\",null]}\n", 19))
+        return;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_file(&v, path, 0));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+    EXPECT_EQ_STRING("b", lept_get_string(lept_get_array_element(lept_find_object_value(&v, "a", 1), 1)), 1);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_file(&v, path, LEPT_PARSE_FLAG_POPULATE | LEPT_PARSE_FLAG_HUGEPAGES | LEPT_PARSE_FLAG_INDEXED));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+    lept_free(&v);
+
+    write_file(path, "", 0);
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_file(&v, path, 0));
+    write_file(path, "[1] 2", 5);
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_file(&v, path, 0));
+
+    /* files filling whole pages, or nearly, end with no readable byte after them */
+    for (len = 4096 - 40; len <= 4096 * 4; len += len < 4096 + 40 ? 8 : 4096) {
+        json = (char*)malloc(len);
+        memset(json, ' ', len);
+        json[0] = '[';
+        memcpy(json + len - 5, "\"\\\\\"", 4);
+        json[len - 1] = ']';
+        write_file(path, json, len);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_file(&v, path, LEPT_PARSE_FLAG_PADDED));
+        EXPECT_EQ_SIZE_T(1, lept_get_array_size(&v));
+        lept_free(&v);
+        json[len - 1] = ' ';
+        write_file(path, json, len);
+        EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_file(&v, path, 0));
+        free(json);
+    }
+    remove(path);
+}
+
 static void test_parse() {
     test_parse_null();
     test_parse_true();
     test_parse_false();
     test_parse_number();
+    test_parse_number_long_exponent();
+    test_parse_integer();
     test_parse_string();
     test_parse_array();
     test_parse_object();
+    test_parse_n();
+    test_parse_indexed();
+    test_parse_insitu();
 
     test_parse_expect_value();
     test_parse_invalid_value();
@@ -367,6 +1438,18 @@ static void test_parse() {
     test_parse_miss_key();
     test_parse_miss_colon();
     test_parse_miss_comma_or_curly_bracket();
+    test_parse_depth_exceeded();
+    test_parse_invalid_utf8();
+    test_parse_sax();
+    test_parse_push();
+    test_parse_reuse();
+    test_parse_document();
+    test_parse_intern_keys();
+    test_parse_duplicates();
+    test_parse_stream();
+    test_parse_lines();
+    test_parse_file();
+    test_parse_validate();
 }
 
 #define TEST_ROUNDTRIP(json)\
@@ -403,6 +1486,10 @@ static void test_stringify_number() {
     TEST_ROUNDTRIP("-2.2250738585072014e-308");
     TEST_ROUNDTRIP("1.7976931348623157e+308");  /* Max double */
     TEST_ROUNDTRIP("-1.7976931348623157e+308");
+
+    TEST_ROUNDTRIP("9007199254740993");
+    TEST_ROUNDTRIP("-9223372036854775808");
+    TEST_ROUNDTRIP("18446744073709551615");
 }
 
 static void test_stringify_string() {
@@ -423,6 +1510,47 @@ static void test_stringify_object() {
     TEST_ROUNDTRIP("{\"n\":null,\"f\":false,\"t\":true,\"i\":123,\"s\":\"abc\",\"a\":[1,2,3],\"o\":{\"1\":1,\"2\":2,\"3\":3}}");
 }
 
+static void test_stringify_writer() {
+    static const char* inputs[] = {
+        "null", "[]", "{\"n\":null,\"a\":[1,2.5,\"x\\ny\"],\"o\":{\"k\":true}}", "\"Hello\\u0000World\"", "-123"
+    };
+    lept_writer* w = lept_writer_create();
+    lept_value v;
+    const char* s;
+    char* big;
+    size_t i, length;
+
+    for (i = 0; i < sizeof(inputs) / sizeof(inputs[0]) * 2; i++) {
+        const char* json = inputs[i % (sizeof(inputs) / sizeof(inputs[0]))];
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+        s = lept_writer_stringify(w, &v, &length);
+        EXPECT_EQ_BASE(strcmp(json, s) == 0, json, s, "%s");
+        EXPECT_EQ_SIZE_T(strlen(json), length);
+        lept_free(&v);
+    }
+
+    /* a text larger than the keep size, then a small one in the trimmed buffer */
+    lept_writer_set_keep_size(w, 1024);
+    big = (char*)malloc(100003);
+    memset(big + 1, 'a', 100001);
+    big[0] = big[100001] = '"';
+    big[100002] = '\0';
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, big));
+    s = lept_writer_stringify(w, &v, &length);
+    EXPECT_EQ_BASE(strcmp(big, s) == 0, big, s, "%s");
+    EXPECT_EQ_SIZE_T(100002, length);
+    lept_free(&v);
+    free(big);
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[true]"));
+    s = lept_writer_stringify(w, &v, &length);
+    EXPECT_EQ_STRING("[true]", s, length);
+    lept_free(&v);
+    lept_writer_free(w);
+}
+
 static void test_stringify() {
     TEST_ROUNDTRIP("null");
     TEST_ROUNDTRIP("false");
@@ -431,6 +1559,7 @@ static void test_stringify() {
     test_stringify_string();
     test_stringify_array();
     test_stringify_object();
+    test_stringify_writer();
 }
 
 #define TEST_EQUAL(json1, json2, equality) \
@@ -453,6 +1582,8 @@ static void test_equal() {
     TEST_EQUAL("null", "0", 0);
     TEST_EQUAL("123", "123", 1);
     TEST_EQUAL("123", "456", 0);
+    TEST_EQUAL("123", "123.0", 1);
+    TEST_EQUAL("9007199254740993", "9007199254740992", 0);
     TEST_EQUAL("\"abc\"", "\"abc\"", 1);
     TEST_EQUAL("\"abc\"", "\"abcd\"", 0);
     TEST_EQUAL("[]", "[]", 1);
@@ -539,6 +1670,23 @@ static void test_access_number() {
     lept_free(&v);
 }
 
+static void test_access_integer() {
+    lept_value v;
+    lept_init(&v);
+    lept_set_string(&v, "a", 1);
+    lept_set_int64(&v, -9007199254740993);
+    EXPECT_TRUE(lept_is_int64(&v));
+    EXPECT_FALSE(lept_is_uint64(&v));
+    EXPECT_TRUE(lept_get_int64(&v) == -9007199254740993);
+    lept_set_uint64(&v, 18446744073709551615u);
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_TRUE(lept_get_uint64(&v) == 18446744073709551615u);
+    lept_set_number(&v, 1234.5);
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_EQ_DOUBLE(1234.5, lept_get_number(&v));
+    lept_free(&v);
+}
+
 static void test_access_string() {
     lept_value v;
     lept_init(&v);
@@ -549,6 +1697,50 @@ static void test_access_string() {
     lept_free(&v);
 }
 
+static void test_access_inline_string() {
+    const char* s = "0123456789abcdef\0ghijklmnopqrstuvwxyz", *p, *q;
+    lept_document* d = lept_document_create();
+    const lept_value* e;
+    lept_value v, w, h;
+    size_t len;
+    lept_init(&v);
+    lept_init(&w);
+    lept_init(&h);
+    lept_set_string(&h, s, 38);
+    EXPECT_FALSE(lept_get_string(&h) == NULL || (h.flags & LEPT_FLAG_INLINE));
+    for (len = 0; len <= LEPT_STRING_INLINE_MAX + 2; len++) {
+        lept_set_string(&v, s, len);
+        EXPECT_EQ_INT(len <= LEPT_STRING_INLINE_MAX, (v.flags & LEPT_FLAG_INLINE) != 0);
+        EXPECT_EQ_SIZE_T(len, lept_get_string_length(&v));
+        EXPECT_TRUE(memcmp(lept_get_string(&v), s, len) == 0 && lept_get_string(&v)[len] == '\0');
+        lept_copy(&w, &v);
+        EXPECT_TRUE(lept_is_equal(&v, &w));
+        lept_swap(&w, &h);
+        EXPECT_EQ_SIZE_T(38, lept_get_string_length(&w));
+        EXPECT_EQ_SIZE_T(len, lept_get_string_length(&h));
+        EXPECT_TRUE(lept_is_equal(&v, &h));
+        lept_swap(&w, &h);
+        lept_move(&w, &v);
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+        EXPECT_EQ_SIZE_T(len, lept_get_string_length(&w));
+        EXPECT_TRUE(memcmp(lept_get_string(&w), s, len) == 0);
+    }
+    lept_free(&w);
+    lept_free(&h);
+
+    /* an inline string's pointer is into its value: growing the parent array moves it, a heap string stays */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, "[\"abc\",\"0123456789abcdefghijklmnopqrstuvwxyz\"]", 46, 0));
+    e = lept_get_array_element(lept_document_root(d), 0);
+    p = lept_get_string(e);
+    q = lept_get_string(lept_get_array_element(lept_document_root(d), 1));
+    EXPECT_TRUE(p >= (const char*)e && p < (const char*)(e + 1));
+    lept_pushback_array_element(lept_document_root(d)); /* out of the arena, onto the heap */
+    EXPECT_FALSE(lept_get_string(lept_get_array_element(lept_document_root(d), 0)) == p);
+    EXPECT_EQ_STRING("abc", lept_get_string(lept_get_array_element(lept_document_root(d), 0)), 3);
+    EXPECT_TRUE(lept_get_string(lept_get_array_element(lept_document_root(d), 1)) == q);
+    lept_document_free(d);
+}
+
 static void test_access_array() {
     lept_value a, e;
     size_t i, j;
@@ -698,13 +1890,222 @@ static void test_access_object() {
 #endif
 }
 
+static void test_access_large_object() {
+    static const size_t sizes[] = { 3, 15, 16, 17, 1000, 20000 };
+    lept_document* d = lept_document_create();
+    lept_value v, w;
+    char key[16], *json;
+    size_t i, j, k, n;
+
+    lept_init(&v);
+    lept_init(&w);
+    for (j = 0; j < sizeof(sizes) / sizeof(sizes[0]); j++) {
+        n = sizes[j];
+        json = object_of(n);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+        EXPECT_EQ_SIZE_T(n + 1, lept_get_object_size(&v));
+        /* the first of duplicate keys is found, by the scan and through the index */
+        for (k = 0; k < 2; k++) {
+            if (k == 1) {
+                lept_index_object(&v);
+                EXPECT_EQ_INT(n + 1 >= 16, (v.flags & LEPT_FLAG_INDEXED) != 0);
+            }
+            for (i = 0; i < n; i++) {
+                sprintf(key, "k%u", (unsigned)i);
+                EXPECT_EQ_SIZE_T(i, lept_find_object_index(&v, key, strlen(key)));
+            }
+            EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(&v, "k", 1));
+            EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(&v, "k0\0", 3));
+            sprintf(key, "k%u", (unsigned)n);
+            EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(&v, key, strlen(key)));
+        }
+        /* the index travels with the members */
+        sprintf(key, "k%u", (unsigned)(n - 1));
+        lept_swap(&v, &w);
+        EXPECT_EQ_DOUBLE((double)(n - 1), lept_get_number(lept_find_object_value(&w, key, strlen(key))));
+        lept_move(&v, &w);
+        sprintf(key, "k%u", (unsigned)(n / 2));
+        EXPECT_EQ_DOUBLE((double)(n / 2), lept_get_number(lept_find_object_value(&v, key, strlen(key))));
+
+        /* in a document, by text and by interned key, indexed out of the arena */
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(d, json, strlen(json), LEPT_PARSE_FLAG_INTERN_KEYS));
+        for (k = 0; k < 2; k++) {
+            if (k == 1)
+                lept_index_object(lept_document_root(d));
+            EXPECT_EQ_SIZE_T(n / 2, lept_find_object_index(lept_document_root(d), key, strlen(key)));
+            EXPECT_EQ_SIZE_T(n / 2, lept_find_object_index(lept_document_root(d), lept_document_find_key(d, key, strlen(key)), strlen(key)));
+            EXPECT_EQ_SIZE_T(0, lept_find_object_index(lept_document_root(d), "k0", 2));
+            if (n > 10)
+                EXPECT_EQ_SIZE_T(1, lept_find_object_index(lept_document_root(d), lept_document_find_key(d, "k10", 3), 2));
+        }
+        lept_free(&v);
+        free(json);
+    }
+    lept_document_free(d);
+}
+
 static void test_access() {
     test_access_null();
     test_access_boolean();
     test_access_number();
+    test_access_integer();
     test_access_string();
+    test_access_inline_string();
     test_access_array();
     test_access_object();
+    test_access_large_object();
+}
+
+#define TEST_TAPE_ROUNDTRIP(json)\
+    do {\
+        lept_tape t, t2;\
+        lept_value v;\
+        char* json2;\
+        size_t length;\
+        lept_init(&v);\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_tape(&t, json, strlen(json)));\
+        lept_tape_to_value(&t, 0, &v);\
+        json2 = lept_stringify(&v, &length);\
+        EXPECT_EQ_STRING(json, json2, length);\
+        free(json2);\
+        lept_tape_from_value(&t2, &v);\
+        EXPECT_EQ_SIZE_T(t.nwords, t2.nwords);\
+        EXPECT_TRUE(memcmp(t.words, t2.words, t.nwords * sizeof(uint64_t)) == 0);\
+        lept_free(&v);\
+        lept_tape_free(&t);\
+        lept_tape_free(&t2);\
+    } while(0)
+
+#define TEST_TAPE_ERROR(error, json)\
+    do {\
+        lept_tape t;\
+        lept_value v;\
+        lept_init(&v);\
+        EXPECT_EQ_INT(error, lept_parse_tape(&t, json, strlen(json)));\
+        EXPECT_EQ_INT(error, lept_parse(&v, json));\
+        EXPECT_TRUE(t.words == NULL);\
+        lept_free(&v);\
+    } while(0)
+
+static void test_tape() {
+    const char* json = " { \"n\" : null , \"f\" : false , \"t\" : true , \"i\" : 123 , \"s\" : \"abc\\u0000d\","
+        " \"a\" : [ 1, 2.5, -3, [], {} ] , \"o\" : { \"1\" : 1, \"2\" : 2 } } ";
+    lept_tape t;
+    size_t a, o, e, i;
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_tape(&t, json, strlen(json)));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_tape_get_type(&t, 0));
+    EXPECT_EQ_SIZE_T(7, lept_tape_get_size(&t, 0));
+    EXPECT_EQ_SIZE_T(t.nwords, lept_tape_next(&t, 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_tape_get_type(&t, lept_tape_find_object_value(&t, 0, "n", 1)));
+    EXPECT_FALSE(lept_tape_get_boolean(&t, lept_tape_find_object_value(&t, 0, "f", 1)));
+    EXPECT_TRUE(lept_tape_get_boolean(&t, lept_tape_find_object_value(&t, 0, "t", 1)));
+    EXPECT_EQ_DOUBLE(123.0, lept_tape_get_number(&t, lept_tape_find_object_value(&t, 0, "i", 1)));
+    e = lept_tape_find_object_value(&t, 0, "s", 1);
+    EXPECT_EQ_STRING("abc\0d", lept_tape_get_string(&t, e), lept_tape_get_string_length(&t, e));
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_tape_find_object_value(&t, 0, "x", 1));
+
+    a = lept_tape_find_object_value(&t, 0, "a", 1);
+    EXPECT_EQ_INT(LEPT_ARRAY, lept_tape_get_type(&t, a));
+    EXPECT_EQ_SIZE_T(5, lept_tape_get_size(&t, a));
+    for (i = 0, e = lept_tape_first(&t, a); e != lept_tape_end(&t, a); e = lept_tape_next(&t, e), i++) {
+        static const lept_type types[] = { LEPT_NUMBER, LEPT_NUMBER, LEPT_NUMBER, LEPT_ARRAY, LEPT_OBJECT };
+        EXPECT_EQ_INT(types[i], lept_tape_get_type(&t, e));
+    }
+    EXPECT_EQ_SIZE_T(5, i);
+    EXPECT_EQ_DOUBLE(2.5, lept_tape_get_number(&t, lept_tape_first(&t, a) + 1));
+    EXPECT_EQ_DOUBLE(-3.0, lept_tape_get_number(&t, lept_tape_first(&t, a) + 2));
+
+    o = lept_tape_find_object_value(&t, 0, "o", 1);
+    EXPECT_EQ_SIZE_T(2, lept_tape_get_size(&t, o));
+    e = lept_tape_first(&t, o);
+    EXPECT_EQ_STRING("1", lept_tape_get_string(&t, e), lept_tape_get_string_length(&t, e));
+    EXPECT_EQ_DOUBLE(1.0, lept_tape_get_number(&t, e + 1));
+    e = lept_tape_next(&t, e + 1);
+    EXPECT_EQ_STRING("2", lept_tape_get_string(&t, e), lept_tape_get_string_length(&t, e));
+    EXPECT_EQ_SIZE_T(lept_tape_end(&t, o), lept_tape_next(&t, e + 1));
+    lept_tape_free(&t);
+
+    TEST_TAPE_ROUNDTRIP("null");
+    TEST_TAPE_ROUNDTRIP("\"\"");
+    TEST_TAPE_ROUNDTRIP("[]");
+    TEST_TAPE_ROUNDTRIP("{}");
+    TEST_TAPE_ROUNDTRIP("[-9223372036854775808,18446744073709551615,1.5,1e+100,\"\\n\"]");
+    TEST_TAPE_ROUNDTRIP("{\"a\":[{\"b\":[[],{}]},true,false,null],\"\":{\"\":\"\"}}");
+
+    TEST_TAPE_ERROR(LEPT_PARSE_EXPECT_VALUE, " ");
+    TEST_TAPE_ERROR(LEPT_PARSE_INVALID_VALUE, "[1,]");
+    TEST_TAPE_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR, "[] 1");
+    TEST_TAPE_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "[1e309]");
+    TEST_TAPE_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, "{\"a\":\"b");
+    TEST_TAPE_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE, "[\"\\x\"]");
+    TEST_TAPE_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[[1}");
+    TEST_TAPE_ERROR(LEPT_PARSE_MISS_KEY, "{\"a\":{1:1}}");
+    TEST_TAPE_ERROR(LEPT_PARSE_MISS_COLON, "{\"a\",1}");
+    TEST_TAPE_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":[]]");
+}
+
+static void test_cursor() {
+    const char* json = " { \"skip\" : { \"a\" : [ \"]}\\\"\", {}, [[]] ], \"b\" : not json } , \"k\\u0065y\" : 1.5 ,"
+        " \"list\" : [ 1 , -2 , 3e2 ] , \"empty\" : [ ] , \"v\" : { \"x\" : [ true ] } , \"bad\" : [ 1 , ] , \"trunc\" : [ 1 ";
+    lept_doc d;
+    lept_cursor root, f, e;
+    lept_value v;
+    double n, sum;
+
+    lept_doc_init(&d, json, strlen(json));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_doc_root(&d, &root));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_cursor_get_type(&root));
+
+    /* the invalid member is skipped without being looked at */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_find_field(&root, "key", 3, &f));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_get_double(&f, &n));
+    EXPECT_EQ_DOUBLE(1.5, n);
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_find_field(&root, "list", 4, &f));
+    EXPECT_EQ_INT(LEPT_ARRAY, lept_cursor_get_type(&f));
+    for (sum = 0.0; lept_cursor_array_next(&f, &e) == LEPT_PARSE_OK; sum += n)
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_get_double(&e, &n));
+    EXPECT_EQ_DOUBLE(299.0, sum);
+    EXPECT_EQ_INT(LEPT_CURSOR_ARRAY_END, lept_cursor_array_next(&f, &e));
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_find_field(&root, "empty", 5, &f));
+    EXPECT_EQ_INT(LEPT_CURSOR_ARRAY_END, lept_cursor_array_next(&f, &e));
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_find_field(&root, "v", 1, &f));
+    EXPECT_EQ_INT(LEPT_CURSOR_FIELD_NOT_FOUND, lept_cursor_find_field(&f, "missing", 7, &e));
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_get_value(&f, &v));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_TRUE, lept_get_type(lept_get_array_element(lept_find_object_value(&v, "x", 1), 0)));
+    lept_free(&v);
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_find_field(&root, "skip", 4, &f));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_find_field(&f, "a", 1, &f));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_array_next(&f, &e));
+    EXPECT_EQ_INT(LEPT_STRING, lept_cursor_get_type(&e));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_cursor_get_double(&e, &n));
+
+    /* errors are reported when reached */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_find_field(&root, "bad", 3, &f));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_array_next(&f, &e));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_cursor_array_next(&f, &e));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_find_field(&root, "trunc", 5, &f));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_array_next(&f, &e));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_cursor_array_next(&f, &e));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_cursor_find_field(&root, "after", 5, &f));
+
+    lept_doc_init(&d, " ", 1);
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_doc_root(&d, &root));
+    lept_doc_init(&d, "{\"a\":1 \"b\":2}", 13);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_doc_root(&d, &root));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_cursor_find_field(&root, "b", 1, &f));
+    lept_doc_init(&d, "{\"a\" 1}", 7);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_doc_root(&d, &root));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_cursor_find_field(&root, "a", 1, &f));
+    lept_doc_init(&d, "{\"a\":[1,{\"b\":\"[\"}", 17);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_doc_root(&d, &root));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_cursor_find_field(&root, "c", 1, &f));
 }
 
 int main() {
@@ -718,6 +2119,8 @@ int main() {
     test_move();
     test_swap();
     test_access();
+    test_tape();
+    test_cursor();
     printf("%d/%d (%3.2f%%) passed\n", test_pass, test_count, test_pass * 100.0 / test_count);
     return main_ret;
 }